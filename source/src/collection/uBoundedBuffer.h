@@ -2,7 +2,7 @@
 // 
 // uC++ Version 6.1.0, Copyright (C) Peter A. Buhr 1993
 // 
-// uBoundedBuffer.h -- Generic bounded buffer problem using a monitor and uAccept
+// uBoundedBuffer.h -- Generic bounded buffers using a monitor and uAccept, and lock-free ring buffers
 // 
 // Author           : Peter A. Buhr
 // Created On       : Sun Apr  4 10:20:32 1993
@@ -78,6 +78,349 @@ template<typename ElemType> inline ElemType uBoundedBuffer<ElemType>::remove() {
 } // uBoundedBuffer::remove
 
 
+// Ring buffers that are not monitors: a task only blocks when the buffer is full (producer) or empty (consumer), and
+// otherwise inserts or removes with a few atomic instructions. uRingBuffer allows one producer and one consumer task;
+// uMPRingBuffer allows any number of each. Besides copying insert/remove, an element can be filled in place
+// (reserve/commit) and examined in place (acquire/release), and elements can be moved in groups (insert/remove of n
+// elements), which publishes the group and wakes the waiting tasks once. The number of elements is rounded up to a
+// power of 2.
+
+namespace UPP {
+    class uRingBufferWaiters {				// tasks blocked on a full or empty ring buffer
+        volatile int count;				// waiting tasks not yet chosen for a wakeup
+        uSemaphore waiting;
+        char padding[128 - ( sizeof(int) + sizeof(uSemaphore) ) % 128]; // pad to size of cacheline
+
+        uRingBufferWaiters( uRingBufferWaiters & );	// no copy
+        uRingBufferWaiters &operator=( uRingBufferWaiters & ); // no assignment
+      public:
+        uRingBufferWaiters() : count( 0 ), waiting( 0 ) {}
+
+        // A waiter announces itself, checks the buffer again, and then either blocks or cancels. Announcing is a full
+        // barrier, as is the update that makes elements or slots available before wake is called, so either the waiter
+        // sees the update or the updater sees the waiter.
+
+        void announce() {
+            uFetchAdd( count, 1 );
+        } // uRingBufferWaiters::announce
+
+        void block() {
+            waiting.P();
+        } // uRingBufferWaiters::block
+
+        void cancel() {
+            for ( ;; ) {
+                int c = count;
+              if ( c == 0 ) {				// an updater chose this waiter ?
+                    waiting.P();			// absorb its wakeup
+                    return;
+                } // if
+              if ( uCompareAssign( count, c, c - 1 ) ) return;
+            } // for
+        } // uRingBufferWaiters::cancel
+
+        void wake( int n ) {				// n elements or slots became available
+            for ( ;; ) {
+                int c = count;
+              if ( c == 0 ) return;			// common case, no waiters
+                int k = c < n ? c : n;
+                if ( uCompareAssign( count, c, c - k ) ) {
+                    if ( k == 1 ) waiting.V(); else waiting.V( k );
+                    return;
+                } // if
+            } // for
+        } // uRingBufferWaiters::wake
+    }; // uRingBufferWaiters
+
+    inline unsigned int uRingBufferSize( unsigned int size ) { // round up to power of 2
+        unsigned int s = 2;
+        while ( s < size ) s <<= 1;
+        return s;
+    } // uRingBufferSize
+} // UPP
+
+
+template<typename ElemType> class uRingBuffer {		// single producer, single consumer
+    const unsigned int size, mask;			// number of buffer elements, power of 2
+    ElemType *elements;
+
+    // Each side has a cache line for the index it advances and its last view of the other side's index, so it only
+    // reads the other side's line when its view shows the buffer full or empty.
+    volatile unsigned int back;				// producer: next element to fill
+    unsigned int frontView;
+    char padding1[128 - 2 * sizeof(unsigned int)];	// pad to size of cacheline
+    volatile unsigned int front;			// consumer: next element to empty
+    unsigned int backView;
+    char padding2[128 - 2 * sizeof(unsigned int)];	// pad to size of cacheline
+    UPP::uRingBufferWaiters producer, consumer;
+
+    uRingBuffer( uRingBuffer & );			// no copy
+    uRingBuffer &operator=( uRingBuffer & );		// no assignment
+
+    unsigned int vacant() {				// producer: empty elements, 0 => full
+        unsigned int n = size - ( back - frontView );
+        if ( n == 0 ) {
+            frontView = front;
+            __sync_synchronize();			// consumer finished with elements before reusing them
+            n = size - ( back - frontView );
+        } // if
+        return n;
+    } // uRingBuffer::vacant
+
+    unsigned int filled() {				// consumer: full elements, 0 => empty
+        unsigned int n = backView - front;
+        if ( n == 0 ) {
+            backView = back;
+            __sync_synchronize();			// producer finished with elements before reading them
+            n = backView - front;
+        } // if
+        return n;
+    } // uRingBuffer::filled
+
+    unsigned int waitSlots() {
+        unsigned int n;
+        while ( ( n = vacant() ) == 0 ) {
+            producer.announce();
+            if ( vacant() == 0 ) producer.block(); else producer.cancel();
+        } // while
+        return n;
+    } // uRingBuffer::waitSlots
+
+    unsigned int waitElems() {
+        unsigned int n;
+        while ( ( n = filled() ) == 0 ) {
+            consumer.announce();
+            if ( filled() == 0 ) consumer.block(); else consumer.cancel();
+        } // while
+        return n;
+    } // uRingBuffer::waitElems
+
+    void publish( unsigned int n ) {
+        uFetchAdd( back, n );				// full barrier, elements filled before publishing
+        consumer.wake( n );
+    } // uRingBuffer::publish
+
+    void retire( unsigned int n ) {
+        uFetchAdd( front, n );				// full barrier, elements emptied before reuse
+        producer.wake( n );
+    } // uRingBuffer::retire
+  public:
+    uRingBuffer( const unsigned int size = 10 ) : size( UPP::uRingBufferSize( size ) ), mask( this->size - 1 ) {
+        elements = new ElemType[this->size];
+        back = frontView = front = backView = 0;
+    } // uRingBuffer::uRingBuffer
+
+    ~uRingBuffer() {
+        delete [] elements;
+    } // uRingBuffer::~uRingBuffer
+
+    int query() {
+        return back - front;
+    } // uRingBuffer::query
+
+    void insert( const ElemType &elem ) {
+        reserve() = elem;
+        publish( 1 );
+    } // uRingBuffer::insert
+
+    ElemType remove() {
+        ElemType elem = acquire();
+        retire( 1 );
+        return elem;
+    } // uRingBuffer::remove
+
+    // Fill the returned element in place and then commit it. Only one element may be reserved at a time.
+
+    ElemType &reserve() {
+        waitSlots();
+        return elements[back & mask];
+    } // uRingBuffer::reserve
+
+    void commit( ElemType & ) {
+        publish( 1 );
+    } // uRingBuffer::commit
+
+    // Examine the returned element in place and then release it. Only one element may be acquired at a time.
+
+    ElemType &acquire() {
+        waitElems();
+        return elements[front & mask];
+    } // uRingBuffer::acquire
+
+    void release( ElemType & ) {
+        retire( 1 );
+    } // uRingBuffer::release
+
+    void insert( const ElemType elems[], unsigned int n ) { // insert all n elements, blocking while full
+        for ( unsigned int i = 0; i < n; ) {
+            unsigned int k = waitSlots();
+            if ( k > n - i ) k = n - i;
+            for ( unsigned int j = 0; j < k; j += 1 ) elements[( back + j ) & mask] = elems[i + j];
+            publish( k );
+            i += k;
+        } // for
+    } // uRingBuffer::insert
+
+    unsigned int remove( ElemType elems[], unsigned int n ) { // remove up to n elements, blocking while empty
+        unsigned int k = waitElems();
+        if ( k > n ) k = n;
+        for ( unsigned int j = 0; j < k; j += 1 ) elems[j] = elements[( front + j ) & mask];
+        retire( k );
+        return k;
+    } // uRingBuffer::remove
+}; // uRingBuffer
+
+
+template<typename ElemType> class uMPRingBuffer {	// multiple producers, multiple consumers
+    // Each element has a sequence number telling which lap around the buffer it is on: a producer may fill the element
+    // for position p when its sequence number is p, and a consumer may empty it when its sequence number is p + 1.
+    // Producers and consumers claim positions by advancing back and front with compare-and-swap, and then fill or
+    // empty the claimed elements without further synchronization.
+    struct Cell {
+        volatile unsigned int seq;
+        ElemType elem;
+    }; // Cell
+
+    const unsigned int size, mask;			// number of buffer elements, power of 2
+    Cell *cells;
+    volatile unsigned int back;				// next position to fill
+    char padding1[128 - sizeof(unsigned int)];		// pad to size of cacheline
+    volatile unsigned int front;			// next position to empty
+    char padding2[128 - sizeof(unsigned int)];		// pad to size of cacheline
+    UPP::uRingBufferWaiters producers, consumers;
+
+    uMPRingBuffer( uMPRingBuffer & );			// no copy
+    uMPRingBuffer &operator=( uMPRingBuffer & );	// no assignment
+
+    Cell &cell( unsigned int pos ) {
+        return cells[pos & mask];
+    } // uMPRingBuffer::cell
+
+    Cell &cell( ElemType &elem ) {			// cell containing a reserved or acquired element
+        return cells[( (char *)&elem - (char *)cells ) / sizeof(Cell)];
+    } // uMPRingBuffer::cell
+
+    // Claim up to n consecutive positions whose cells have sequence number position + lap, where lap is 0 for
+    // producers and 1 for consumers. Cells beyond index only change from unclaimable to claimable until index passes
+    // them, so the compare-and-swap on index makes the whole group valid. Returns 0 if the first cell is not ready.
+
+    unsigned int claim( volatile unsigned int &index, unsigned int lap, unsigned int n, unsigned int &pos ) {
+        for ( ;; ) {
+            pos = index;
+            unsigned int k = 0;
+            while ( k < n && cell( pos + k ).seq == pos + k + lap ) k += 1;
+            if ( k == 0 ) {
+              if ( (int)( cell( pos ).seq - ( pos + lap ) ) < 0 ) return 0; // previous lap not finished => full/empty
+                continue;				// index moved
+            } // if
+          if ( uCompareAssign( index, pos, pos + k ) ) return k;
+        } // for
+    } // uMPRingBuffer::claim
+
+    bool ready( volatile unsigned int &index, unsigned int lap ) {
+        unsigned int pos = index;
+        return (int)( cell( pos ).seq - ( pos + lap ) ) >= 0;
+    } // uMPRingBuffer::ready
+
+    unsigned int claimSlots( unsigned int n, unsigned int &pos ) {
+        unsigned int k;
+        while ( ( k = claim( back, 0, n, pos ) ) == 0 ) {
+            producers.announce();
+            if ( ! ready( back, 0 ) ) producers.block(); else producers.cancel();
+        } // while
+        return k;
+    } // uMPRingBuffer::claimSlots
+
+    unsigned int claimElems( unsigned int n, unsigned int &pos ) {
+        unsigned int k;
+        while ( ( k = claim( front, 1, n, pos ) ) == 0 ) {
+            consumers.announce();
+            if ( ! ready( front, 1 ) ) consumers.block(); else consumers.cancel();
+        } // while
+        return k;
+    } // uMPRingBuffer::claimElems
+
+    void advance( unsigned int pos, unsigned int n, unsigned int inc ) { // move n cells to their next state
+        __sync_synchronize();				// elements filled or emptied before advancing
+        for ( unsigned int j = 0; j < n; j += 1 ) cell( pos + j ).seq += inc;
+        __sync_synchronize();				// advance before checking for waiters
+    } // uMPRingBuffer::advance
+  public:
+    uMPRingBuffer( const unsigned int size = 10 ) : size( UPP::uRingBufferSize( size ) ), mask( this->size - 1 ) {
+        cells = new Cell[this->size];
+        for ( unsigned int i = 0; i < this->size; i += 1 ) cells[i].seq = i;
+        back = front = 0;
+    } // uMPRingBuffer::uMPRingBuffer
+
+    ~uMPRingBuffer() {
+        delete [] cells;
+    } // uMPRingBuffer::~uMPRingBuffer
+
+    int query() {					// approximate when tasks are inserting or removing
+        return back - front;
+    } // uMPRingBuffer::query
+
+    void insert( const ElemType &elem ) {
+        ElemType &slot = reserve();
+        slot = elem;
+        commit( slot );
+    } // uMPRingBuffer::insert
+
+    ElemType remove() {
+        ElemType &slot = acquire();
+        ElemType elem = slot;
+        release( slot );
+        return elem;
+    } // uMPRingBuffer::remove
+
+    // Fill the returned element in place and then commit it. Consumers wait at an uncommitted element, so commit
+    // promptly.
+
+    ElemType &reserve() {
+        unsigned int pos;
+        claimSlots( 1, pos );
+        return cell( pos ).elem;
+    } // uMPRingBuffer::reserve
+
+    void commit( ElemType &elem ) {
+        uFetchAdd( cell( elem ).seq, 1 );		// full barrier, element filled before publishing
+        consumers.wake( 1 );
+    } // uMPRingBuffer::commit
+
+    // Examine the returned element in place and then release it. Producers wait at an unreleased element, so release
+    // promptly.
+
+    ElemType &acquire() {
+        unsigned int pos;
+        claimElems( 1, pos );
+        return cell( pos ).elem;
+    } // uMPRingBuffer::acquire
+
+    void release( ElemType &elem ) {
+        uFetchAdd( cell( elem ).seq, mask );		// full barrier, seq becomes position + size for next lap
+        producers.wake( 1 );
+    } // uMPRingBuffer::release
+
+    void insert( const ElemType elems[], unsigned int n ) { // insert all n elements, blocking while full
+        for ( unsigned int i = 0; i < n; ) {
+            unsigned int pos, k = claimSlots( n - i, pos );
+            for ( unsigned int j = 0; j < k; j += 1 ) cell( pos + j ).elem = elems[i + j];
+            advance( pos, k, 1 );
+            consumers.wake( k );
+            i += k;
+        } // for
+    } // uMPRingBuffer::insert
+
+    unsigned int remove( ElemType elems[], unsigned int n ) { // remove up to n elements, blocking while empty
+        unsigned int pos, k = claimElems( n, pos );
+        for ( unsigned int j = 0; j < k; j += 1 ) elems[j] = cell( pos + j ).elem;
+        advance( pos, k, mask );
+        producers.wake( k );
+        return k;
+    } // uMPRingBuffer::remove
+}; // uMPRingBuffer
+
+
 #endif // __U_BOUNDEDBUFFER_H__
 
 
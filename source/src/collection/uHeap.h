@@ -209,6 +209,19 @@ template<typename KeyType, typename DataType, template<typename Elt> class Array
 	heapify( 1 );
     } // uGenericHeap::deletenode
 
+    void deleteAt( int i ) {				// remove element at subscript i
+#ifdef __U_DEBUG__
+	assert( 0 < i && i <= heapSize );
+#endif // __U_DEBUG__
+	exchange( A[i], A[size()] );
+	heapSize -= 1;
+	if ( i <= size() ) {				// last element moved into the hole ?
+	    // the moved element may belong above or below the hole
+	    for ( ; i > 1 && compare( A[parent( i )].key, A[i].key ) == -1; exchange( A[i], A[parent( i )] ), i = parent( i ) );
+	    heapify( i );
+	} // if
+    } // uGenericHeap::deleteAt
+
     void insert( KeyType key, DataType data ) {		// insert element into heap
 	heapSize += 1;
 	A[heapSize].key = key;
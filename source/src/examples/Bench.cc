@@ -642,6 +642,57 @@ _Task ContextSwitch {
     } // ContextSwitch
 }; // ContextSwitch
 
+//=======================================
+// time ready-queue scaling
+//=======================================
+
+inline long long int WallTime() {			// Time is per kernel thread, so use elapsed time across processors
+    timespec ts;
+    clock_gettime( CLOCK_REALTIME, &ts );
+    return 1000000000LL * ts.tv_sec + ts.tv_nsec;
+} // WallTime
+
+_Task Yielder {
+    int N;
+
+    void main() {
+	for ( int i = 1; i <= N; i += 1 ) {
+	    yield();
+	} // for
+    } // Yielder::main
+  public:
+    Yielder( uCluster &cluster, int N ) : uBaseTask( cluster ) {
+	Yielder::N = N;
+    } // Yielder
+}; // Yielder
+
+enum { MaxProcessors = 8, TasksPerProcessor = 4 };
+
+void ReadyQueueScaling( uCluster::ReadyQueueMode mode, unsigned int Processors, int NoOfTimes ) {
+    long long int StartTime, EndTime;
+    const unsigned int Tasks = TasksPerProcessor * Processors; // keep every processor busy
+    const int N = NoOfTimes / Tasks;			// total number of yields is independent of processors
+    uCluster cluster( mode, "scaling" );
+    uProcessor *processors[MaxProcessors];
+    Yielder *yielders[TasksPerProcessor * MaxProcessors];
+
+    for ( unsigned int i = 0; i < Processors; i += 1 ) {
+	processors[i] = new uProcessor( cluster );
+    } // for
+    StartTime = WallTime();
+    for ( unsigned int i = 0; i < Tasks; i += 1 ) {
+	yielders[i] = new Yielder( cluster, N );
+    } // for
+    for ( unsigned int i = 0; i < Tasks; i += 1 ) {
+	delete yielders[i];
+    } // for
+    EndTime = WallTime();
+    for ( unsigned int i = 0; i < Processors; i += 1 ) {
+	delete processors[i];
+    } // for
+    osacquire( cerr ) << "\t " << ( EndTime - StartTime ) / ( (long long int)Tasks * N );
+} // ReadyQueueScaling
+
 //=======================================
 // benchmark driver
 //=======================================
@@ -739,6 +790,20 @@ void uMain::main() {
 	ContextSwitch dummy( NoOfTimes );		// context switch
     }
     osacquire( cerr ) << "\t" << endl;
+
+    // Aggregate elapsed time per yield with 4 yielding tasks per processor, comparing the single cluster ready-queue
+    // with per-processor ready-queues and work stealing. Lower is better; flat or falling values as processors are
+    // added indicate the ready queue is not a bottleneck.
+
+    osacquire( cerr ) << endl << "ready\t\tshared\tstealing" << endl;
+    osacquire( cerr ) << "(nsecs)\t\tyield\tyield" << endl;
+    long int cpus = sysconf( _SC_NPROCESSORS_ONLN );
+    for ( unsigned int p = 1; p <= MaxProcessors && p <= (unsigned long int)cpus; p += p ) {
+	osacquire( cerr ) << p << " procs\t";
+	ReadyQueueScaling( uCluster::SharedReadyQueue, p, NoOfTimes );
+	ReadyQueueScaling( uCluster::WorkStealingReadyQueue, p, NoOfTimes );
+	osacquire( cerr ) << "\t" << endl;
+    } // for
 } // uMain::main
 
 // Local Variables: //
@@ -0,0 +1,140 @@
+//                              -*- Mode: C++ -*-
+//
+// uC++ Version 6.1.0, Copyright (C) Peter A. Buhr 2015
+//
+// BufferBench.cc -- Cost of passing an element through the monitor bounded buffer and the ring buffers.
+//
+// Author           : Peter A. Buhr
+// Created On       : Mon Jan 26 10:05:18 2015
+// Last Modified By : Peter A. Buhr
+// Last Modified On : Mon Jan 26 16:40:02 2015
+// Update Count     : 17
+//
+
+#include <uBoundedBuffer.h>
+#include <iostream>
+#include <cstdlib>					// atoi
+using std::cerr;
+using std::osacquire;
+using std::endl;
+
+unsigned int uDefaultPreemption() {
+    return 0;
+} // uDefaultPreemption
+
+unsigned long long int Now() {
+    return uThisProcessor().getClock().getTime().nanoseconds();
+} // Now
+
+enum { Size = 64, Batch = 16 };
+
+// The monitor buffer has no group operations, so move the elements one at a time.
+
+template<typename Buffer> void Insert( Buffer &buf, const int elems[], unsigned int n ) {
+    buf.insert( elems, n );
+} // Insert
+
+void Insert( uBoundedBuffer<int> &buf, const int elems[], unsigned int n ) {
+    for ( unsigned int i = 0; i < n; i += 1 ) buf.insert( elems[i] );
+} // Insert
+
+template<typename Buffer> unsigned int Remove( Buffer &buf, int elems[], unsigned int n ) {
+    return buf.remove( elems, n );
+} // Remove
+
+unsigned int Remove( uBoundedBuffer<int> &buf, int elems[], unsigned int n ) {
+    for ( unsigned int i = 0; i < n; i += 1 ) elems[i] = buf.remove();
+    return n;
+} // Remove
+
+template<typename Buffer> _Task Producer {
+    Buffer &buf;
+    unsigned int N, batch;
+
+    void main() {
+	int elems[Batch];
+	if ( batch == 1 ) {
+	    for ( unsigned int i = 0; i < N; i += 1 ) buf.insert( i );
+	} else {
+	    for ( unsigned int i = 0; i < N; i += batch ) {
+		for ( unsigned int j = 0; j < batch; j += 1 ) elems[j] = i + j;
+		Insert( buf, elems, batch );
+	    } // for
+	} // if
+    } // Producer::main
+  public:
+    Producer( Buffer &buf, unsigned int N, unsigned int batch ) : buf( buf ), N( N ), batch( batch ) {}
+}; // Producer
+
+template<typename Buffer> _Task Consumer {
+    Buffer &buf;
+    unsigned int N, batch;
+    unsigned long long int &sum;
+
+    void main() {
+	int elems[Batch];
+	unsigned long long int total = 0;
+	if ( batch == 1 ) {
+	    for ( unsigned int i = 0; i < N; i += 1 ) total += buf.remove();
+	} else {
+	    for ( unsigned int i = 0; i < N; ) {
+		unsigned int n = Remove( buf, elems, batch < N - i ? batch : N - i );
+		for ( unsigned int j = 0; j < n; j += 1 ) total += elems[j];
+		i += n;
+	    } // for
+	} // if
+	sum = total;
+    } // Consumer::main
+  public:
+    Consumer( Buffer &buf, unsigned int N, unsigned int batch, unsigned long long int &sum ) : buf( buf ), N( N ), batch( batch ), sum( sum ) {}
+}; // Consumer
+
+// Each of the pairs producers inserts N elements and each of the pairs consumers removes N elements.
+
+template<typename Buffer> void Run( unsigned int N, unsigned int pairs, unsigned int batch ) {
+    Buffer buf( Size );
+    unsigned long long int sums[pairs], total = 0;
+    unsigned long long int StartTime = Now();
+    {
+	Consumer<Buffer> *cons[pairs];
+	Producer<Buffer> *prods[pairs];
+	for ( unsigned int i = 0; i < pairs; i += 1 ) cons[i] = new Consumer<Buffer>( buf, N, batch, sums[i] );
+	for ( unsigned int i = 0; i < pairs; i += 1 ) prods[i] = new Producer<Buffer>( buf, N, batch );
+	for ( unsigned int i = 0; i < pairs; i += 1 ) delete prods[i];
+	for ( unsigned int i = 0; i < pairs; i += 1 ) delete cons[i];
+    }
+    unsigned long long int EndTime = Now();
+    for ( unsigned int i = 0; i < pairs; i += 1 ) total += sums[i];
+    if ( total != (unsigned long long int)N * ( N - 1 ) / 2 * pairs ) uAbort( "BufferBench: wrong total %llu", total );
+    osacquire( cerr ) << "\t " << ( EndTime - StartTime ) / ( (unsigned long long int)N * pairs );
+} // Run
+
+void uMain::main() {
+    const unsigned int N = argc > 1 ? atoi( argv[1] ) / Batch * Batch : 200000; // multiple of batch size
+    const unsigned int processors = argc > 2 ? atoi( argv[2] ) : 2;
+
+    uProcessor *extra[processors];
+    for ( unsigned int i = 1; i < processors; i += 1 ) extra[i] = new uProcessor;
+
+    osacquire( cerr ) << "\t\t\tmonitor\tring\tmp ring (ns per element, " << processors << " processors)" << endl;
+    osacquire( cerr ) << "1 producer/consumer\t";
+    Run< uBoundedBuffer<int> >( N, 1, 1 );
+    Run< uRingBuffer<int> >( N, 1, 1 );
+    Run< uMPRingBuffer<int> >( N, 1, 1 );
+    osacquire( cerr ) << endl << "  batch " << Batch << "\t\t\t";
+    Run< uRingBuffer<int> >( N, 1, Batch );
+    Run< uMPRingBuffer<int> >( N, 1, Batch );
+    osacquire( cerr ) << endl << "4 producers/consumers\t";
+    Run< uBoundedBuffer<int> >( N, 4, 1 );
+    osacquire( cerr ) << "\t";
+    Run< uMPRingBuffer<int> >( N, 4, 1 );
+    osacquire( cerr ) << endl << "  batch " << Batch << "\t\t\t\t";
+    Run< uMPRingBuffer<int> >( N, 4, Batch );
+    osacquire( cerr ) << endl;
+
+    for ( unsigned int i = 1; i < processors; i += 1 ) delete extra[i];
+} // uMain::main
+
+// Local Variables: //
+// compile-command: "../../bin/u++ -O2 -multi -nodebug BufferBench.cc" //
+// End: //
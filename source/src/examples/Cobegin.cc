@@ -2,7 +2,7 @@
 // 
 // uC++ Version 6.1.0, Copyright (C) Peter A. Buhr 2014
 // 
-// Cobegin.cc -- Check COBEGIN/COEND, COFOR, and START/WAIT concurrency control structures.
+// Cobegin.cc -- Check COBEGIN/COEND, COFOR, parallel for, and START/WAIT concurrency control structures.
 // 
 // Author           : Peter A. Buhr
 // Created On       : Sat Dec 27 18:20:07 2014
@@ -65,14 +65,37 @@ void uMain::main() {
 	} // for
     ); // COFOR
 
-    // START/WAIT
-
     for ( unsigned int r = 0; r < rows; r += 1 ) {	// sequential
 	total += subtotals[r];
     } // for
 
     std::cout << "total:" << total << std::endl;
 
+    // Parallel for
+
+    const unsigned int N = 1000000;
+    uProcessor processors[3];				// extra workers in multiprocessor
+    unsigned int *squares = new unsigned int[N];
+
+    uParallelFor( 0, N, [&]( unsigned int i ) { squares[i] = i % 1000 * (i % 1000); } );
+    unsigned long long int sum = uParallelReduce( 0, N, 0ULL,	// default grain
+	[&]( unsigned int i ) { return (unsigned long long int)squares[i]; },
+	[]( unsigned long long int a, unsigned long long int b ) { return a + b; } );
+    std::cout << "sum:" << sum << std::endl;
+    unsigned int maxi = 0;
+    uOwnerLock maxLock;
+    uParallelForRange( 0, N, [&]( unsigned int lo, unsigned int hi ) { // per chunk
+	unsigned int m = 0;
+	for ( unsigned int i = lo; i < hi; i += 1 ) if ( squares[i] > m ) m = squares[i];
+	maxLock.acquire();
+	if ( m > maxi ) maxi = m;
+	maxLock.release();
+    }, 4096 );
+    std::cout << "max:" << maxi << std::endl;
+    delete [] squares;
+
+    // START/WAIT
+
     auto tp = START( p, 2, 4.1 );
     std::cout << "m1" << std::endl;			// concurrent
     WAIT( tp );
@@ -0,0 +1,100 @@
+//                              -*- Mode: C++ -*-
+//
+// uC++ Version 6.1.0, Copyright (C) Peter A. Buhr 2015
+//
+// ExecutorBench.cc -- Throughput of small jobs for the monitor-buffer and stealing modes of uExecutor.
+//
+// Author           : Peter A. Buhr
+// Created On       : Mon Jan 12 09:14:27 2015
+// Last Modified By : Peter A. Buhr
+// Last Modified On : Mon Jan 12 11:02:51 2015
+// Update Count     : 21
+//
+
+#include <uFuture.h>
+#include <iostream>
+#include <cstdlib>					// atoi
+using std::cerr;
+using std::osacquire;
+using std::endl;
+
+unsigned int uDefaultPreemption() {
+    return 0;
+} // uDefaultPreemption
+
+struct Work {						// small job
+    unsigned int n;
+    unsigned long long int operator()() const {
+	unsigned long long int sum = 0;
+	for ( unsigned int i = 0; i < n; i += 1 ) sum += i;
+	return sum;
+    } // Work::operator()
+}; // Work
+
+unsigned long long int Now() {
+    return uThisProcessor().getClock().getTime().nanoseconds();
+} // Now
+
+// Fire-and-forget jobs; deleting the executor waits for all jobs to finish.
+
+void Send( unsigned int N, unsigned int workers, bool stealing, unsigned int batch ) {
+    Work work = { 10 };
+    Work *works = new Work[batch];
+    for ( unsigned int i = 0; i < batch; i += 1 ) works[i] = work;
+
+    unsigned long long int StartTime = Now();
+    {
+	uExecutor executor( workers, stealing );
+	if ( batch == 1 ) {
+	    for ( unsigned int i = 0; i < N; i += 1 ) executor.send( work );
+	} else {
+	    for ( unsigned int i = 0; i < N; i += batch ) executor.send( works, batch );
+	} // if
+    }
+    unsigned long long int EndTime = Now();
+    delete [] works;
+    osacquire( cerr ) << "\t " << ( EndTime - StartTime ) / N;
+} // Send
+
+// Jobs with results, where the submitter waits for every result.
+
+void Submit( unsigned int N, unsigned int workers, bool stealing ) {
+    Work work = { 10 };
+    const unsigned int Group = 1000;			// outstanding futures
+    Future_ISM<unsigned long long int> *results = new Future_ISM<unsigned long long int>[Group];
+    unsigned long long int total = 0;
+
+    unsigned long long int StartTime = Now();
+    {
+	uExecutor executor( workers, stealing );
+	for ( unsigned int i = 0; i < N; i += Group ) {
+	    for ( unsigned int g = 0; g < Group; g += 1 ) executor.submit( results[g], work );
+	    for ( unsigned int g = 0; g < Group; g += 1 ) total += results[g]();
+	} // for
+    }
+    unsigned long long int EndTime = Now();
+    delete [] results;
+    if ( total != (unsigned long long int)N * 45 ) uAbort( "ExecutorBench: wrong total %llu", total );
+    osacquire( cerr ) << "\t " << ( EndTime - StartTime ) / N;
+} // Submit
+
+void uMain::main() {
+    const unsigned int N = argc > 1 ? atoi( argv[1] ) / 1000 * 1000 : 500000; // multiple of batch and group sizes
+    const unsigned int workers = argc > 2 ? atoi( argv[2] ) : 4;
+
+    osacquire( cerr ) << "\t\t\t\tmonitor\tstealing (ns per job, " << workers << " workers)" << endl;
+    osacquire( cerr ) << "send\t\t\t";
+    Send( N, workers, false, 1 );
+    Send( N, workers, true, 1 );
+    osacquire( cerr ) << endl << "send, batch 64\t\t";
+    Send( N / 64 * 64, workers, false, 64 );
+    Send( N / 64 * 64, workers, true, 64 );
+    osacquire( cerr ) << endl << "submit/wait\t\t";
+    Submit( N, workers, false );
+    Submit( N, workers, true );
+    osacquire( cerr ) << endl;
+} // uMain::main
+
+// Local Variables: //
+// compile-command: "../../bin/u++ -O2 -multi -nodebug ExecutorBench.cc" //
+// End: //
@@ -0,0 +1,102 @@
+//                              -*- Mode: C++ -*-
+//
+// uC++ Version 6.1.0, Copyright (C) Peter A. Buhr 2015
+//
+// FutureChain.cc -- Futures in caller-provided and pooled storage, and chains of continuations.
+//
+// Author           : Peter A. Buhr
+// Created On       : Wed Jan 28 09:17:44 2015
+// Last Modified By : Peter A. Buhr
+// Last Modified On : Wed Jan 28 14:03:21 2015
+// Update Count     : 23
+//
+
+#include <uFuture.h>
+#include <iostream>
+using std::cerr;
+using std::endl;
+
+_Event StageFailure {};
+
+struct Twice {						// continuation: next stage from previous result
+    int operator()( Future_ISM<int> &f ) { return f() * 2; }
+}; // Twice
+
+struct Record {						// continuation: note order of execution
+    int &order, expect;
+    Record( int &order, int expect ) : order( order ), expect( expect ) {}
+    void operator()( Future_ISM<int> & ) {
+	if ( order != expect ) uAbort( "FutureChain: continuation %d ran out of order", expect );
+	order = expect + 1;
+    } // Record::operator()
+}; // Record
+
+struct Ident {						// executor request
+    int i;
+    int operator()() { return i; }
+}; // Ident
+
+void uMain::main() {
+    {							// caller-provided storage, no heap allocation
+	Future_ISM<int>::Storage storage;
+	Future_ISM<int> f( storage );
+	{
+	    Future_ISM<int> copy = f;
+	    copy.delivery( 3 );
+	}
+	if ( f() != 3 ) uAbort( "FutureChain: wrong result from storage future" );
+    }
+    {							// pooled storage, recycled when last copy deleted
+	Future_ISM<int>::Pool pool;
+	for ( int i = 0; i < 1000; i += 1 ) {
+	    Future_ISM<int> f( pool ), copy = f;
+	    f.delivery( i );
+	    if ( copy() != i ) uAbort( "FutureChain: wrong result from pooled future" );
+	} // for
+    }
+    {							// continuations on delivering task, in registration order
+	Future_ISM<int> f;
+	int order = 0;
+	f.then( Record( order, 0 ) );
+	f.then( Record( order, 1 ) );
+	Future_ISM<int> chain = f.then<int>( Twice() ).then<int>( Twice() );
+	f.delivery( 5 );
+	if ( order != 2 || chain() != 20 ) uAbort( "FutureChain: wrong chain result" );
+	f.then( Record( order, 2 ) );			// already available => run immediately
+	if ( order != 3 ) uAbort( "FutureChain: continuation not run on available future" );
+    }
+    {							// exception and cancellation flow down a chain
+	Future_ISM<int> f, g;
+	Future_ISM<int> c1 = f.then<int>( Twice() ), c2 = g.then<int>( Twice() );
+	f.exception( new StageFailure );
+	g.cancel();
+	try {
+	    c1();
+	    uAbort( "FutureChain: exception not propagated" );
+	} catch( StageFailure & ) {
+	} // try
+	try {
+	    c2();
+	    uAbort( "FutureChain: cancellation not propagated" );
+	} catch( Future_ISM<int>::Cancellation & ) {
+	} // try
+    }
+    for ( int stealing = 0; stealing < 2; stealing += 1 ) { // chains run by executor, no task blocks per stage
+	enum { N = 1000 };
+	uExecutor executor( 2, stealing );
+	Future_ISM<int> results[N], chains[N];
+	long int sum = 0;
+	for ( int i = 0; i < N; i += 1 ) {
+	    Ident action = { i };
+	    executor.submit( results[i], action );
+	    chains[i] = results[i].then<int>( executor, Twice() ).then<int>( executor, Twice() );
+	} // for
+	for ( int i = 0; i < N; i += 1 ) sum += chains[i]();
+	if ( sum != 4L * N * ( N - 1 ) / 2 ) uAbort( "FutureChain: wrong executor chain total %ld", sum );
+    } // for
+    cerr << "successful completion" << endl;
+} // uMain::main
+
+// Local Variables: //
+// compile-command: "u++ FutureChain.cc" //
+// End: //
@@ -0,0 +1,151 @@
+//                              -*- Mode: C++ -*-
+//
+// uC++ Version 6.1.0, Copyright (C) Peter A. Buhr 2015
+//
+// DatagramBatch.cc -- Batched and scatter-gather INET/datagram socket test. A client sends batches of datagrams with
+//     sendmmsg, each gathered from a header and a payload buffer, and the server drains each batch with one recvmmsg
+//     and echoes it back with one sendmmsg.
+//
+// Author           : Peter A. Buhr
+// Created On       : Thu Feb  5 09:26:11 2015
+// Last Modified By : Peter A. Buhr
+// Last Modified On : Thu Feb  5 16:02:38 2015
+// Update Count     : 21
+//
+
+#include <uSocket.h>
+#include <iostream>
+#include <cstdlib>					// atoi
+using std::cerr;
+using std::osacquire;
+using std::endl;
+
+enum { Batch = 32, Size = 64 };
+const int Stop = -1;								// header of last datagram
+
+struct Messages {										// batch of datagrams, each a header and a payload
+	struct mmsghdr msgs[Batch];
+	struct iovec iovs[Batch][2];
+	int headers[Batch];
+	char payloads[Batch][Size];
+	sockaddr_in addrs[Batch];
+
+	void reset( struct sockaddr *to, socklen_t tolen ) { // to == NULL => receive addresses
+		memset( msgs, '\0', sizeof(msgs) );
+		for ( unsigned int i = 0; i < Batch; i += 1 ) {
+			iovs[i][0].iov_base = &headers[i];
+			iovs[i][0].iov_len = sizeof(headers[i]);
+			iovs[i][1].iov_base = payloads[i];
+			iovs[i][1].iov_len = Size;
+			msgs[i].msg_hdr.msg_iov = iovs[i];
+			msgs[i].msg_hdr.msg_iovlen = 2;
+			msgs[i].msg_hdr.msg_name = to != NULL ? to : (struct sockaddr *)&addrs[i];
+			msgs[i].msg_hdr.msg_namelen = to != NULL ? tolen : sizeof(addrs[i]);
+		} // for
+	} // Messages::reset
+}; // Messages
+
+_Task Server {
+	uSocketServer &server;
+	Messages m;
+
+	void main() {
+		uDuration timeout( 20, 0 );						// timeout for read
+		unsigned int calls = 0, received = 0;
+		for ( ;; ) {
+			m.reset( NULL, 0 );
+			int n = server.recvmmsg( m.msgs, Batch, 0, &timeout ); // all datagrams queued, up to Batch
+			calls += 1;
+			received += n;
+			for ( int i = 0; i < n; i += 1 ) {
+				m.iovs[i][1].iov_len = m.msgs[i].msg_len - sizeof(int); // echo received length
+				if ( m.headers[i] == Stop ) {			// last datagram arrives alone
+					server.sendtov( m.iovs[i], 1, (struct sockaddr *)&m.addrs[i], m.msgs[i].msg_hdr.msg_namelen );
+					osacquire( cerr ) << "server received " << received - 1 << " datagrams in " << calls << " calls" << endl;
+					return;
+				} // if
+			} // for
+			for ( int sent = 0; sent < n; ) {			// echo batch to senders
+				sent += server.sendmmsg( m.msgs + sent, n - sent );
+			} // for
+		} // for
+	} // Server::main
+  public:
+	Server( uSocketServer &server ) : server( server ) {}
+}; // Server
+
+_Task Client {
+	unsigned short port;
+	unsigned int N;
+	Messages out, in;
+
+	void main() {
+		uSocketClient client( port, SOCK_DGRAM );
+		uDuration timeout( 20, 0 );						// timeout for read
+		struct sockaddr *to = (struct sockaddr *)client.getsockaddr(); // server address
+		out.reset( to, sizeof(sockaddr_in) );
+
+		for ( unsigned int i = 0; i < N; i += Batch ) {
+			for ( unsigned int j = 0; j < Batch; j += 1 ) { // gather header and payload into each datagram
+				out.headers[j] = i + j;
+				out.iovs[j][1].iov_len = ( i + j ) % Size + 1;
+				memset( out.payloads[j], ( i + j ) % 256, out.iovs[j][1].iov_len );
+			} // for
+			for ( unsigned int sent = 0; sent < Batch; ) {
+				sent += client.sendmmsg( out.msgs + sent, Batch - sent );
+			} // for
+			in.reset( NULL, 0 );
+			for ( unsigned int recvd = 0; recvd < Batch; ) { // echoes arrive in one or more batches
+				recvd += client.recvmmsg( in.msgs + recvd, Batch - recvd, 0, &timeout );
+			} // for
+			for ( unsigned int j = 0; j < Batch; j += 1 ) {
+				int seq = in.headers[j];
+				unsigned int len = in.msgs[j].msg_len - sizeof(int);
+				if ( seq < (int)i || seq >= (int)( i + Batch ) || len != (unsigned int)seq % Size + 1 ) {
+					uAbort( "client : bad echo of datagram %d, length %u", seq, len );
+				} // if
+				for ( unsigned int k = 0; k < len; k += 1 ) {
+					if ( (unsigned char)in.payloads[j][k] != seq % 256 ) uAbort( "client : bad echo data in datagram %d", seq );
+				} // for
+			} // for
+		} // for
+
+		struct iovec stop = { (void *)&Stop, sizeof(Stop) };
+		client.sendtov( &stop, 1 );						// default address
+		int header;
+		struct iovec ack = { &header, sizeof(header) };
+		if ( client.recvfromv( &ack, 1, 0, &timeout ) != sizeof(header) || header != Stop ) {
+			uAbort( "client : bad stop acknowledgement" );
+		} // if
+	} // Client::main
+  public:
+	Client( unsigned short port, unsigned int N ) : port( port ), N( N ) {}
+}; // Client
+
+void uMain::main() {
+	unsigned int N = 20000;
+	switch ( argc ) {
+	  case 2:
+		N = atoi( argv[1] ) / Batch * Batch;			// multiple of batch size
+		if ( N > 0 ) break;
+		// FALL THROUGH
+	  default:
+		cerr << "Usage: " << argv[0] << " [ datagrams (>= " << Batch << ") ]" << endl;
+		exit( EXIT_FAILURE );
+	  case 1:
+		break;
+	} // switch
+
+	short unsigned int port;
+	uSocketServer server( &port, SOCK_DGRAM );			// create and bind a server socket to free port
+	{
+		Server s( server );
+		Client c( port, N );
+	}
+	cerr << "successful completion" << endl;
+} // uMain
+
+// Local Variables: //
+// tab-width: 4 //
+// compile-command: "u++-work DatagramBatch.cc" //
+// End: //
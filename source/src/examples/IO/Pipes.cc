@@ -65,7 +65,7 @@ _Task Reader {
 	     << endl;
 
 #ifdef __U_STATISTICS__
-	unsigned int tselect_syscalls = 0;
+	UPP::Statistics::Counters total = {}, interval; // running totals, and counts since the last line
 #endif // __U_STATISTICS__
 	try {
 	    for ( ;; ) {
@@ -77,13 +77,13 @@ _Task Reader {
 		select_calls += 1;
 		end = uThisProcessor().getClock().getTime();
 		uDuration diff = end - start;
-#ifdef __U_STATISTICS__
-		tselect_syscalls = UPP::Statistics::select_syscalls - tselect_syscalls;
-#endif // __U_STATISTICS__
 
 		//cout << start << " " << end << " " << diff << endl;
 	    
 		if ( diff >= pollFreq ) {
+#ifdef __U_STATISTICS__
+		    UPP::Statistics::delta( total, interval );
+#endif // __U_STATISTICS__
 		    read_mbps = do_reader_bytes / diff / 1000000.0;
 		    cout << setw(7) << diff.nanoseconds() / 1000000000.0
 			 << "\t" << setw(7) << select_calls
@@ -91,25 +91,22 @@ _Task Reader {
 			 << "\t" << setw(7) << read_mbps
 #ifdef __U_STATISTICS__
 			 << "\t" << setw(7) << UPP::Statistics::select_maxFD
-			 << "\t" << setw(7) << UPP::Statistics::spins / 1000
-			 << "\t" << setw(7) << UPP::Statistics::spin_sched
-			 << "\t" << setw(7) << UPP::Statistics::ready_queue
-			 << "\t" << setw(7) << UPP::Statistics::mutex_queue
-			 << "\t" << setw(5) << UPP::Statistics::owner_lock_queue << "/" << UPP::Statistics::adaptive_lock_queue
-			 << "\t" << setw(7) << UPP::Statistics::io_lock_queue
-			 << "\t" << setw(7) << UPP::Statistics::select_events
-			 << "\t" << setw(7) << UPP::Statistics::select_nothing
-			 << "\t" << setw(7) << UPP::Statistics::select_blocking
-			 << "\t" << setw(7) << UPP::Statistics::select_pending / UPP::Statistics::select_syscalls
-			 << "\t" << setw(7) << UPP::Statistics::select_syscalls
+			 << "\t" << setw(7) << interval.spins / 1000
+			 << "\t" << setw(7) << interval.spin_sched
+			 << "\t" << setw(7) << total.ready_queue
+			 << "\t" << setw(7) << total.mutex_queue
+			 << "\t" << setw(5) << total.owner_lock_queue << "/" << total.adaptive_lock_queue
+			 << "\t" << setw(7) << total.io_lock_queue
+			 << "\t" << setw(7) << interval.select_events
+			 << "\t" << setw(7) << interval.select_nothing
+			 << "\t" << setw(7) << interval.select_blocking
+			 << "\t" << setw(7) << (interval.select_syscalls != 0 ? UPP::Statistics::select_pending / interval.select_syscalls : 0)
+			 << "\t" << setw(7) << interval.select_syscalls
 #endif // __U_STATISTICS__
 			 << endl;
 		    select_calls = select_fds = 0;
 		    do_reader_bytes = 0;
 		    start = end;
-#ifdef __U_STATISTICS__
-		    tselect_syscalls = UPP::Statistics::select_syscalls;
-#endif // __U_STATISTICS__
 		} // if
 	    } // for
 	} catch( uPipe::End::ReadTimeout ) {
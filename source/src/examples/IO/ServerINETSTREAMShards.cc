@@ -0,0 +1,139 @@
+//                              -*- Mode: C++ -*-
+//
+// uC++ Version 6.1.0, Copyright (C) Peter A. Buhr 2015
+//
+// ServerINETSTREAMShards.cc -- Server for INET/stream socket test using SO_REUSEPORT shards. Each shard has its own
+//     listening socket, cluster and processor, and a server task on the shard's cluster creates acceptors for its
+//     shard. An acceptor reads the data from a client and writes it back on the processor that accepted the connection.
+//
+// Author           : Peter A. Buhr
+// Created On       : Tue Feb  3 10:12:47 2015
+// Last Modified By : Peter A. Buhr
+// Last Modified On : Tue Feb  3 15:31:09 2015
+// Update Count     : 14
+//
+
+#include <uSocket.h>
+#include <iostream>
+#include <cstdlib>					// atoi
+using std::cout;
+using std::cerr;
+using std::osacquire;
+using std::endl;
+
+enum { BufferSize = 8 * 1024 };
+const char EOD = '\377';
+const char EOT = '\376';
+
+_Task Server;						// forward declaration
+
+_Task Acceptor {
+	uSocketServer &sockserver;
+	Server &server;
+
+	void main();
+  public:
+	Acceptor( uCluster &cluster, uSocketServer &socks, Server &server ) : uBaseTask( cluster ), sockserver( socks ), server( server ) {
+	} // Acceptor::Acceptor
+}; // Acceptor
+
+_Task Server {
+	uSocketServerShards &shards;
+	Acceptor *terminate;
+	int acceptorCnt;
+	bool timeout;
+  public:
+	Server( uCluster &cluster, uSocketServerShards &shards ) : uBaseTask( cluster ), shards( shards ), acceptorCnt( 1 ), timeout( false ) {
+	} // Server::Server
+
+	void connection() {
+	} // Server::connection
+
+	void complete( Acceptor *terminate, bool timeout ) {
+		Server::terminate = terminate;
+		Server::timeout = timeout;
+	} // Server::complete
+  private:
+	void main() {
+		uSocketServer &sockserver = shards.local();		// shard of this cluster
+		new Acceptor( uThisCluster(), sockserver, *this ); // create initial acceptor
+		for ( ;; ) {
+			_Accept( connection ) {
+				new Acceptor( uThisCluster(), sockserver, *this ); // create new acceptor after a connection
+				acceptorCnt += 1;
+			} or _Accept( complete ) {					// acceptor has completed with client
+				delete terminate;						// delete must appear here or deadlock
+				acceptorCnt -= 1;
+		  if ( acceptorCnt == 0 ) break;				// if no outstanding connections, stop
+				if ( timeout ) {
+					new Acceptor( uThisCluster(), sockserver, *this ); // create new acceptor after a timeout
+					acceptorCnt += 1;
+				} // if
+			} // _Accept
+		} // for
+	} // Server::main
+}; // Server
+
+void Acceptor::main() {
+	try {
+		uDuration timeout( 20, 0 );						// timeout for accept
+		uSocketAccept acceptor( sockserver, &timeout );	// accept a connection from a client
+		char buf[BufferSize];
+		int len;
+
+		server.connection();							// tell server about client connection
+		for ( ;; ) {
+			len = acceptor.read( buf, sizeof(buf) );	// read byte from client
+		  if ( len == 0 ) uAbort( "server %d : EOF ecountered without EOD", getpid() );
+			acceptor.write( buf, len );					// write byte back to client
+			// The EOD character can be piggy-backed onto the end of the message.
+		  if ( buf[len - 1] == EOD ) break;				// end of data ?
+		} // for
+		len = acceptor.read( buf, sizeof(buf) );		// read EOT from client
+		if ( len != 1 && buf[0] != EOT ) {
+			uAbort( "server %d : failed to read EOT", getpid() );
+		} // if
+		server.complete( this, false );					// terminate
+	} catch( uSocketAccept::OpenTimeout ) {
+		server.complete( this, true );					// terminate
+	} // try
+} // Acceptor::main
+
+void uMain::main() {
+	int nshards = 4;
+	switch ( argc ) {
+	  case 2:
+		nshards = atoi( argv[1] );
+		if ( nshards > 0 ) break;
+		// FALL THROUGH
+	  default:
+		cerr << "Usage: " << argv[0] << " [ shards (> 0) ]" << endl;
+		exit( EXIT_FAILURE );
+	  case 1:
+		break;
+	} // switch
+
+	short unsigned int port;
+	uSocketServerShards shards( nshards, &port );		// create and bind server sockets to the same free port
+
+	cout << port << endl;								// print out free port for clients
+	{
+		Server *servers[nshards];
+		for ( int i = 0; i < nshards; i += 1 ) {
+			servers[i] = new Server( shards.cluster( i ), shards ); // execute until acceptors time out
+		} // for
+		for ( int i = 0; i < nshards; i += 1 ) {
+			delete servers[i];
+		} // for
+	}
+#ifdef __U_STATISTICS__
+	for ( int i = 0; i < nshards; i += 1 ) {
+		osacquire( cerr ) << "shard " << i << " accept calls " << shards[i].acceptSyscalls() << " / errors " << shards[i].acceptErrors() << endl;
+	} // for
+#endif // __U_STATISTICS__
+} // uMain
+
+// Local Variables: //
+// tab-width: 4 //
+// compile-command: "u++-work ServerINETSTREAMShards.cc -o Server" //
+// End: //
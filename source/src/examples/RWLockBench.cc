@@ -0,0 +1,93 @@
+//                              -*- Mode: C++ -*-
+//
+// uC++ Version 6.1.0, Copyright (C) Peter A. Buhr 2015
+//
+// RWLockBench.cc -- Cost of a read-mostly critical section for the queueing and reader-scalable reader-writer locks.
+//
+// Author           : Peter A. Buhr
+// Created On       : Fri Jan 23 14:02:36 2015
+// Last Modified By : Peter A. Buhr
+// Last Modified On : Fri Jan 23 16:48:10 2015
+// Update Count     : 9
+//
+
+#include <uRWLock.h>
+#include <iostream>
+#include <cstdlib>					// atoi
+using std::cerr;
+using std::osacquire;
+using std::endl;
+
+unsigned int uDefaultPreemption() {
+    return 0;
+} // uDefaultPreemption
+
+unsigned long long int Now() {
+    return uThisProcessor().getClock().getTime().nanoseconds();
+} // Now
+
+uRWLock queueing;					// all readers share one spin lock and counter
+uScalableRWLock scalable;				// readers write per-processor counters
+volatile unsigned int table[2];				// shared data, writers keep both entries equal
+
+template<typename Lock> _Task Tester {
+    Lock &lock;
+    unsigned int N, writes;				// one write in "writes" operations, 0 => read only
+
+    void main() {
+	for ( unsigned int i = 0; i < N; i += 1 ) {
+	    if ( writes != 0 && i % writes == 0 ) {
+		lock.wracquire();
+		table[0] += 1;				// critical section
+		yield();				// let readers try to observe the partial update
+		table[1] += 1;
+		lock.wrrelease();
+	    } else {
+		lock.rdacquire();
+		if ( table[0] != table[1] ) uAbort( "RWLockBench: reader saw a partial update %u %u", table[0], table[1] );
+		lock.rdrelease();
+	    } // if
+	} // for
+    } // Tester::main
+  public:
+    Tester( Lock &lock, unsigned int N, unsigned int writes ) : lock( lock ), N( N ), writes( writes ) {}
+}; // Tester
+
+template<typename Lock> void Run( Lock &lock, unsigned int N, unsigned int tasks, unsigned int writes ) {
+    table[0] = table[1] = 0;
+    unsigned long long int StartTime = Now();
+    {
+	Tester<Lock> *testers[tasks];
+	for ( unsigned int i = 0; i < tasks; i += 1 ) testers[i] = new Tester<Lock>( lock, N, writes );
+	for ( unsigned int i = 0; i < tasks; i += 1 ) delete testers[i];
+    }
+    unsigned long long int EndTime = Now();
+    unsigned int expected = writes == 0 ? 0 : ( N + writes - 1 ) / writes * tasks;
+    if ( table[0] != expected || table[1] != expected ) uAbort( "RWLockBench: lost update %u %u, expected %u", table[0], table[1], expected );
+    osacquire( cerr ) << "\t " << ( EndTime - StartTime ) / ( (unsigned long long int)N * tasks );
+} // Run
+
+void uMain::main() {
+    const unsigned int N = argc > 1 ? atoi( argv[1] ) : 100000;
+    const unsigned int processors = argc > 2 ? atoi( argv[2] ) : 4;
+
+    uProcessor *extra[processors];
+    for ( unsigned int i = 1; i < processors; i += 1 ) extra[i] = new uProcessor;
+
+    static const unsigned int writes[] = { 0, 1000, 10 };
+    osacquire( cerr ) << "tasks\twrites\tqueue\tscalable (ns per operation, " << processors << " processors)" << endl;
+    for ( unsigned int tasks = 1; tasks <= processors * 2; tasks *= 2 ) {
+	for ( unsigned int w = 0; w < sizeof(writes) / sizeof(writes[0]); w += 1 ) {
+	    osacquire( cerr ) << tasks << "\t" << ( writes[w] == 0 ? "none" : writes[w] == 10 ? "1/10" : "1/1000" );
+	    Run( queueing, N, tasks, writes[w] );
+	    Run( scalable, N, tasks, writes[w] );
+	    osacquire( cerr ) << endl;
+	} // for
+    } // for
+
+    for ( unsigned int i = 1; i < processors; i += 1 ) delete extra[i];
+} // uMain::main
+
+// Local Variables: //
+// compile-command: "../../bin/u++ -O2 -multi -nodebug RWLockBench.cc" //
+// End: //
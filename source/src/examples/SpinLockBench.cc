@@ -0,0 +1,82 @@
+//                              -*- Mode: C++ -*-
+//
+// uC++ Version 6.1.0, Copyright (C) Peter A. Buhr 2015
+//
+// SpinLockBench.cc -- Cost of a contended acquire/release for the compact, padded, and queue spin locks.
+//
+// Author           : Peter A. Buhr
+// Created On       : Tue Jan 20 10:31:05 2015
+// Last Modified By : Peter A. Buhr
+// Last Modified On : Tue Jan 20 12:17:44 2015
+// Update Count     : 14
+//
+
+#include <iostream>
+#include <cstdlib>					// atoi
+using std::cerr;
+using std::osacquire;
+using std::endl;
+
+unsigned int uDefaultPreemption() {
+    return 0;
+} // uDefaultPreemption
+
+unsigned long long int Now() {
+    return uThisProcessor().getClock().getTime().nanoseconds();
+} // Now
+
+uSpinLock compact;					// lock and neighbouring data may share a cache line
+uAlignedSpinLock padded;				// lock on its own cache line
+uMCSLock queue;						// each waiter spins on its own node
+volatile unsigned long long int counter;		// shared data protected by the lock
+
+template<typename Lock> _Task Tester {
+    Lock &lock;
+    unsigned int N;
+
+    void main() {
+	for ( unsigned int i = 0; i < N; i += 1 ) {
+	    lock.acquire();
+	    counter += 1;				// critical section
+	    lock.release();
+	} // for
+    } // Tester::main
+  public:
+    Tester( Lock &lock, unsigned int N ) : lock( lock ), N( N ) {}
+}; // Tester
+
+template<typename Lock> void Run( Lock &lock, unsigned int N, unsigned int tasks ) {
+    counter = 0;
+    unsigned long long int StartTime = Now();
+    {
+	Tester<Lock> *testers[tasks];
+	for ( unsigned int i = 0; i < tasks; i += 1 ) testers[i] = new Tester<Lock>( lock, N );
+	for ( unsigned int i = 0; i < tasks; i += 1 ) delete testers[i];
+    }
+    unsigned long long int EndTime = Now();
+    if ( counter != (unsigned long long int)N * tasks ) uAbort( "SpinLockBench: mutual exclusion violation, count %llu", counter );
+    osacquire( cerr ) << "\t " << ( EndTime - StartTime ) / ( (unsigned long long int)N * tasks );
+} // Run
+
+void uMain::main() {
+    const unsigned int N = argc > 1 ? atoi( argv[1] ) : 100000;
+    const unsigned int processors = argc > 2 ? atoi( argv[2] ) : 4;
+
+    uProcessor *extra[processors];
+    for ( unsigned int i = 1; i < processors; i += 1 ) extra[i] = new uProcessor;
+
+    osacquire( cerr ) << "tasks\tcompact\tpadded\tqueue (ns per acquire, " << processors << " processors)" << endl;
+    for ( unsigned int tasks = 1; tasks <= processors * 2; tasks *= 2 ) {
+	osacquire( cerr ) << tasks;
+	Run( compact, N, tasks );
+	Run( padded, N, tasks );
+	Run( queue, N, tasks );
+	osacquire( cerr ) << endl;
+    } // for
+
+    for ( unsigned int i = 1; i < processors; i += 1 ) delete extra[i];
+} // uMain::main
+
+// Local Variables: //
+// compile-command: "../../bin/u++ -O2 -multi -nodebug SpinLockBench.cc" //
+// End: //
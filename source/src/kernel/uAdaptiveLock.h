@@ -133,11 +133,11 @@ template< int acquireSpins = 0, int trySpins = 0, int releaseSpins = 0 > class u
 	for ( ;; ) {
 	    waiting.addTail( &(task.entryRef) );	// suspend current task
 #ifdef __U_STATISTICS__
-	    uFetchAdd( UPP::Statistics::adaptive_lock_queue, 1 );
+	    uFetchAdd( UPP::Statistics::counters().adaptive_lock_queue, 1 );
 #endif // __U_STATISTICS__
 	    UPP::uProcessorKernel::schedule( &spin );	// atomically release owner spin lock and block
 #ifdef __U_STATISTICS__
-	    uFetchAdd( UPP::Statistics::adaptive_lock_queue, -1 );
+	    uFetchAdd( UPP::Statistics::counters().adaptive_lock_queue, -1 );
 #endif // __U_STATISTICS__
 	    if ( tryacquireInternal( task, acquireSpins ) ) {
 		waker = 0;
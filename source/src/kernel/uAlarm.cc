@@ -46,6 +46,14 @@
 #include <uC++.h>
 #include <unistd.h>					// access: getpid
 //#include <uDebug.h>
+#if defined( __U_PROCESSOR_TIMER__ )
+#include <cstring>					// strerror, memset
+#include <sys/syscall.h>				// SYS_gettid
+
+#if ! defined( sigev_notify_thread_id )
+#define sigev_notify_thread_id _sigev_un._tid
+#endif // ! sigev_notify_thread_id
+#endif // __U_PROCESSOR_TIMER__
 
 
 using namespace UPP;
@@ -56,13 +64,14 @@ using namespace UPP;
 
 void uEventNode::createEventNode( uBaseTask *task, uSignalHandler *sig, uTime alarm, uDuration period ) {
 #ifdef __U_STATISTICS__
-    uFetchAdd( Statistics::events, 1 );
+    uFetchAdd( Statistics::counters().events, 1 );
 #endif // __U_STATISTICS__
     uEventNode::alarm = alarm;
     uEventNode::period = period;
     uEventNode::task = task;
     sigHandler = sig;
     executeLocked = false;
+    list = NULL;
 } // uEventNode::createEventNode
 
 
@@ -87,7 +96,9 @@ void uEventNode::add( bool block ) {
     uDebugPrtBuf( buf, "(uEventNode &)%p.add( %d ) alarm:%lld period:%lld\n", this, block, alarm.nanoseconds(), period.nanoseconds() );
 #endif // __U_DEBUG_H__
 
-    uProcessor::events->addEvent( *this, block );
+    // With per-processor timers, a task preempted before the list is locked may add to the list of the processor it was
+    // executing on. That is harmless unless the processor is deleted in between, so retry on the current processor.
+    while ( ! uThisProcessor().events->addEvent( *this, block ) );
 } // uEventNode::add
 
 
@@ -97,14 +108,146 @@ void uEventNode::remove() {
     uDebugPrtBuf( buf, "(uEventNode &)%p.remove alarm:%lld period:%lld\n", this, alarm.nanoseconds(), period.nanoseconds() );
 #endif // __U_DEBUG_H__
 
-    uProcessor::events->removeEvent( *this );
+  if ( list == NULL ) return;				// never added ?
+    // Retry if the event is moved to another list before the list is locked because its processor is deleted.
+    while ( ! list->removeEvent( *this ) );
 } // uEventNode::remove
 
 
 //######################### uEventList #########################
 
 
-void uEventList::addEvent( uEventNode &newEvent, bool block ) {
+uEventList::uEventList() {
+    for ( unsigned int level = 0; level < WheelLevels; level += 1 ) {
+	occupied[level] = 0;
+    } // for
+    wheelTime = 0;
+    count = 0;
+#if defined( __U_PROCESSOR_TIMER__ )
+    owner = NULL;
+    nextRetired = NULL;
+#endif // __U_PROCESSOR_TIMER__
+} // uEventList::uEventList
+
+
+unsigned long long int uEventList::tick( uTime time ) {
+    long long int ns = time.nanoseconds();
+    return ns <= 0 ? 0 : (unsigned long long int)ns >> TickShift;
+} // uEventList::tick
+
+
+void uEventList::file( uEventNode &event ) {
+    unsigned long long int when = tick( event.alarm );
+    unsigned int level, slot;
+
+    if ( when <= wheelTime ) {				// current or past tick ?
+	level = 0;
+	slot = wheelTime & (WheelSlots - 1);
+    } else {
+	level = (63 - __builtin_clzll( when ^ wheelTime )) / WheelBits; // highest tick digit that differs
+	slot = (when >> (level * WheelBits)) & (WheelSlots - 1);
+    } // if
+    assert( level < WheelLevels );
+    event.bucket = level * WheelSlots + slot;
+
+    uSequence<uEventNode> &bucket = wheel[event.bucket];
+    if ( level == 0 ) {					// level-0 buckets are sorted
+	// Search from the end as alarms are mostly added in increasing order; equal alarms stay FIFO.
+	uEventNode *aft;
+	for ( aft = bucket.tail(); aft != NULL && aft->alarm > event.alarm; aft = bucket.pred( aft ) );
+	bucket.insertAft( aft, &event );
+    } else {
+	bucket.addTail( &event );
+    } // if
+    occupied[level] |= 1ULL << slot;
+} // uEventList::file
+
+
+void uEventList::insert( uEventNode &event ) {
+    if ( count == 0 ) {					// empty wheel ? => restart at current time
+	wheelTime = tick( activeProcessorKernel->kernelClock.getTime() );
+    } // if
+    count += 1;
+    file( event );
+} // uEventList::insert
+
+
+void uEventList::unlink( uEventNode &event ) {
+    uSequence<uEventNode> &bucket = wheel[event.bucket];
+    bucket.remove( &event );
+    if ( bucket.empty() ) {
+	occupied[event.bucket / WheelSlots] &= ~(1ULL << (event.bucket % WheelSlots));
+    } // if
+    count -= 1;
+} // uEventList::unlink
+
+
+int uEventList::firstBucket() const {
+    for ( unsigned int level = 0; level < WheelLevels; level += 1 ) {
+	// Buckets before the wheel time are empty. At level 0, the current bucket holds the current and past ticks; at
+	// higher levels, the current bucket is empty because its events are filed at a lower level.
+	unsigned int from = ((wheelTime >> (level * WheelBits)) & (WheelSlots - 1)) + (level == 0 ? 0 : 1);
+      if ( from == WheelSlots ) continue;
+	unsigned long long int pending = occupied[level] & (~0ULL << from);
+      if ( pending != 0 ) return level * WheelSlots + __builtin_ctzll( pending );
+    } // for
+    return -1;
+} // uEventList::firstBucket
+
+
+unsigned long long int uEventList::bucketTick( int bucket ) const {
+    unsigned int shift = bucket / WheelSlots * WheelBits;
+    return (wheelTime >> (shift + WheelBits) << (shift + WheelBits)) | ((unsigned long long int)(bucket % WheelSlots) << shift);
+} // uEventList::bucketTick
+
+
+uTime uEventList::nextAlarm() const {
+    int bucket = firstBucket();
+  if ( bucket == -1 ) return 0;				// no events
+  if ( bucket < WheelSlots ) return wheel[bucket].head()->alarm; // level-0 buckets are sorted => exact
+    // Higher-level bucket: expire at its start so the bucket cascades, and then the exact alarm is set.
+    long long int ns = bucketTick( bucket ) << TickShift;
+    return uTime( ns / TIMEGRAN, ns % TIMEGRAN );
+} // uEventList::nextAlarm
+
+
+void uEventList::advance( unsigned long long int to ) { // pre: no events between the wheel time and to
+    unsigned long long int changed = wheelTime ^ to;
+    wheelTime = to;
+  if ( changed < WheelSlots ) return;			// same level-0 range ? => nothing to cascade
+
+    // Cascade from the highest level whose digit changed, so events refiled at a lower level are cascaded in turn.
+    for ( unsigned int level = (63 - __builtin_clzll( changed )) / WheelBits; level > 0; level -= 1 ) {
+	unsigned int slot = (to >> (level * WheelBits)) & (WheelSlots - 1);
+	uSequence<uEventNode> &bucket = wheel[level * WheelSlots + slot];
+	for ( uEventNode *event; (event = bucket.dropHead()) != NULL; ) {
+	    file( *event );				// always at a lower level
+	} // for
+	occupied[level] &= ~(1ULL << slot);
+    } // for
+} // uEventList::advance
+
+
+uEventNode *uEventList::dequeue( uTime now ) {
+    unsigned long long int target = tick( now );
+
+    for ( ;; ) {
+	uEventNode *event = wheel[wheelTime & (WheelSlots - 1)].head();
+	if ( event != NULL ) {				// current bucket sorted and holds all earlier events
+	  if ( event->alarm > now ) return NULL;
+	    unlink( *event );
+	    return event;
+	} // if
+      if ( wheelTime >= target ) return NULL;
+	int bucket = firstBucket();
+      if ( bucket == -1 ) return NULL;			// no events
+	unsigned long long int next = bucketTick( bucket );
+	advance( next < target ? next : target );	// skip empty buckets
+    } // for
+} // uEventList::dequeue
+
+
+bool uEventList::addEvent( uEventNode &newEvent, bool block ) {
 #ifdef __U_DEBUG_H__
     char buf[1024];
     uDebugPrtBuf( buf, "(uEventList &)%p.addEvent, newEvent:%p\n", this, &newEvent );
@@ -112,11 +255,19 @@ void uEventList::addEvent( uEventNode &newEvent, bool block ) {
 
     eventLock.acquire();
 
-    uEventNode *event;
-    for ( uSeqIter<uEventNode> iter( eventlist ); iter >> event && event->alarm <= newEvent.alarm; ); // find position to insert
-    eventlist.insertBef( &newEvent, event );		// insert in list
-    if ( eventlist.head() == &newEvent ) {		// inserted at front ?
-	setTimer( newEvent.alarm );			// reset alarm
+#if defined( __U_PROCESSOR_TIMER__ )
+  if ( owner == NULL ) {				// processor deleted ?
+	eventLock.release();
+	return false;
+    } // if
+#endif // __U_PROCESSOR_TIMER__
+
+    newEvent.list = this;
+    uTime prev = nextAlarm();
+    insert( newEvent );
+    uTime next = nextAlarm();
+    if ( next != prev ) {				// inserted at front ?
+	setTimer( next );				// reset alarm
     } // if
 
     if ( block ) {
@@ -124,10 +275,11 @@ void uEventList::addEvent( uEventNode &newEvent, bool block ) {
     } else {
 	eventLock.release();
     } // if
+    return true;
 } // uEventList::addEvent
 
 
-void uEventList::removeEvent( uEventNode &event ) {
+bool uEventList::removeEvent( uEventNode &event ) {
 #ifdef __U_DEBUG_H__
     char buf[1024];
     uDebugPrtBuf( buf, "(uEventList &)%p.removeEvent, event:%p\n", this, &event );
@@ -135,42 +287,97 @@ void uEventList::removeEvent( uEventNode &event ) {
 
     eventLock.acquire();
 
+  if ( event.list != this ) {				// moved to another list ?
+	eventLock.release();
+	return false;
+    } // if
+
     // If a task is trying to remove an event at the same time the event expires, both the task and roll forward race to
     // remove the event.  One succeeds and the other finds the node not listed.
   if ( ! event.listed() ) {				// node already removed ?
 	eventLock.release();
-	return;
+	return true;
     } // if
 
-    uEventNode *head = eventlist.head();
-    eventlist.remove( &event );
+    uTime prev = nextAlarm();
+    unlink( event );
+    uTime next = nextAlarm();
 
-    if ( head == &event ) {				// remove at head ? => reset alarm
-	if ( eventlist.empty() ) {			// list empty ?
+    if ( next != prev ) {				// remove at head ? => reset alarm
+	if ( count == 0 ) {				// list empty ?
 	    setTimer( uDuration( 0 ) );			// cancel alarm
 	} else {
-	    setTimer( eventlist.head()->alarm );	// reset alarm
+	    setTimer( next );				// reset alarm
 	} // if
     } // if
 
     eventLock.release();
+    return true;
 } // uEventList::removeEvent
 
 
+#if defined( __U_PROCESSOR_TIMER__ )
+void uEventList::createTimer( uProcessor &processor ) {
+    sigevent sev;
+    memset( &sev, 0, sizeof( sev ) );
+    sev.sigev_notify = SIGEV_THREAD_ID;			// signal only this kernel thread
+    sev.sigev_signo = SIGALRM;
+    sev.sigev_notify_thread_id = syscall( SYS_gettid );
+    if ( timer_create( CLOCK_REALTIME, &sev, &timer ) == -1 ) {
+	uAbort( "(uEventList &)%p.createTimer() : internal error, timer_create failed, error(%d) %s.", this, errno, strerror( errno ) );
+    } // if
+
+    eventLock.acquire();
+    owner = &processor;
+    uTime next = nextAlarm();				// events left by tasks preempted while list was retired
+    if ( next != 0 ) {
+	setTimer( next );
+    } // if
+    eventLock.release();
+} // uEventList::createTimer
+
+
+void uEventList::retire( uEventList &to ) {
+    eventLock.acquire();
+    to.eventLock.acquire();
+
+    owner = NULL;					// reject further adds
+    timer_delete( timer );
+
+    // Tasks blocked with a timeout may outlive the processor on which they blocked.
+    uTime prev = to.nextAlarm();
+    for ( int bucket; ( bucket = firstBucket() ) != -1; ) {
+	uEventNode *event = wheel[bucket].head();
+	unlink( *event );
+	event->list = &to;
+	to.insert( *event );
+    } // for
+    uTime next = to.nextAlarm();
+    if ( next != prev ) {				// moved events at front ?
+	to.setTimer( next );				// reset alarm
+    } // if
+
+    to.eventLock.release();
+    eventLock.release();
+} // uEventList::retire
+#endif // __U_PROCESSOR_TIMER__
+
+
 #if ! defined( __U_MULTI__ )
 bool uEventList::userEventPresent() {
     eventLock.acquire();
 
-    uEventNode *event;
-    uSeqIter<uEventNode> iter(eventlist);
+    uEventNode *event = NULL;
 
     // Only one context-switch event in uniprocessor as there is only one real processor and the other processors are
-    // simulated. Now check for any task waiting other than system task. Loop executes at most 3 iterations
-    for ( int i = 0; iter >> event && ( uProcessor::contextSwitchHandler == event->sigHandler // ignore context switch event
-					|| event->task == (uBaseTask *)uKernelModule::systemTask ); // ignore system task
-	  i += 1
-	) {
-	assert( i < 3 );
+    // simulated. Now check for any task waiting other than system task. Loop skips at most 3 events
+    for ( unsigned int bucket = 0, i = 0; event == NULL && bucket < WheelLevels * WheelSlots; bucket += 1 ) {
+	for ( uSeqIter<uEventNode> iter( wheel[bucket] ); iter >> event && ( uProcessor::contextSwitchHandler == event->sigHandler // ignore context switch event
+									|| event->task == (uBaseTask *)uKernelModule::systemTask ); // ignore system task
+	      i += 1
+	    ) {
+	    assert( i < 3 );
+	} // for
     } // for
     eventLock.release();
 
@@ -185,7 +392,20 @@ void uEventList::setTimer( uDuration duration ) {
     uDebugPrtBuf( buf, "(uEventList &)%p.setTimer, duration %lld\n", this, duration.nanoseconds() );
 #endif // __U_DEBUG_H__
 
+#if defined( __U_PROCESSOR_TIMER__ )
+  if ( duration <= 0 ) return;				// if duration is zero or negative, it has already past
+
+    itimerspec it;
+    it.it_value = duration;				// fill in the value to the next expiry
+    it.it_interval.tv_sec = 0;				// not periodic
+    it.it_interval.tv_nsec = 0;
+#ifdef __U_STATISTICS__
+    uFetchAdd( Statistics::counters().setitimer, 1 );
+#endif // __U_STATISTICS__
+    timer_settime( timer, 0, &it, NULL );		// set the alarm clock to go off
+#else
     activeProcessorKernel->setTimer( duration );
+#endif // __U_PROCESSOR_TIMER__
 } // uEventList::setTimer
 
 
@@ -213,6 +433,12 @@ void uEventList::setTimer( uTime time ) {		// time parameter is real-time (not v
 	uDebugPrtBuf( buffer, "uEventList::setTimer, kill time:%lld currtime:%lld dur:%lld\n", time.nanoseconds(), currtime.nanoseconds(), dur.nanoseconds() );
 #endif // __U_DEBUG_H__
 	//kill( getpid(), SIGALRM );			// send SIGALRM immediately, works uni and multi processor
+#if defined( __U_PROCESSOR_TIMER__ )
+	if ( owner != &uThisProcessor() ) {		// another processor's list ?
+	    setTimer( uDuration( 0, 1 ) );		// its timer must go off to roll forward
+	    return;
+	} // if
+#endif // __U_PROCESSOR_TIMER__
 	THREAD_SETMEM( RFpending, true );		// force rollForward to be called
     } else {
 	setTimer( dur );
@@ -227,6 +453,9 @@ void uEventListPop::over( uEventList &events, bool inKernel ) {
     uEventListPop::events = &events;
     currTime = activeProcessorKernel->kernelClock.getTime();
     cxtSwHandler = NULL;
+#if defined( __U_PROCESSOR_TIMER__ )
+    wakeupCnt = 0;
+#endif // __U_PROCESSOR_TIMER__
     uEventListPop::inKernel = inKernel;
     assert( ! THREAD_GETMEM( RFinprogress ) );		// should not be on
     THREAD_SETMEM( RFinprogress, true );		// starting roll forward
@@ -235,7 +464,9 @@ void uEventListPop::over( uEventList &events, bool inKernel ) {
 
 
 uEventListPop::uEventListPop( uEventList &events, bool inKernel ) {
-#if defined( __U_MULTI__ )
+#if defined( __U_PROCESSOR_TIMER__ )
+    assert( &events == uThisProcessor().events );
+#elif defined( __U_MULTI__ )
     assert( &uThisProcessor() == uKernelModule::systemProcessor );
 #endif // __U_MULTI__
     over( events, inKernel );
@@ -248,31 +479,39 @@ uEventListPop::~uEventListPop() {
     uDebugPrtBuf( buf, "(uEventListPop &)%p.~uEventListPop\n", this );
 #endif // __U_DEBUG_H__
 
-#if defined( __U_MULTI__ )
+#if defined( __U_PROCESSOR_TIMER__ )
+    assert( events == uThisProcessor().events );
+#elif defined( __U_MULTI__ )
     assert( &uThisProcessor() == uKernelModule::systemProcessor );
 #endif // __U_MULTI__
 
     events->eventLock.acquire_( true );
-    uEventNode *head = events->eventlist.head();	// optimization
-    if ( head != NULL && ! THREAD_GETMEM( RFpending ) ) { // reset timer to next available event
-	events->setTimer( head->alarm );
+    uTime next = events->nextAlarm();			// optimization
+    if ( next != 0 && ! THREAD_GETMEM( RFpending ) ) {	// reset timer to next available event
+	events->setTimer( next );
     } // if
     THREAD_SETMEM( RFinprogress, false );
     events->eventLock.release();			// triggers new rollForward if RFpending
 
-#if defined( __U_MULTI__ )
+#if defined( __U_PROCESSOR_TIMER__ )
+    for ( unsigned int i = 0; i < wakeupCnt; i += 1 ) {
+	wakeupList[i]->processorPoke();
+    } // for
+#elif defined( __U_MULTI__ )
     // should work without locking
     uClusterDL *clus;
     for ( uSeqIter<uClusterDL> iter( wakeupList ); iter >> clus; ) {
 	wakeupList.remove( clus );
 	clus->cluster().processorPoke();
     } // for
-#endif // __U_MULTI__
+#endif // __U_PROCESSOR_TIMER__ / __U_MULTI__
 
     if ( ! inKernel ) {					// not in kernel ?
-#if defined( __U_MULTI__ )
+	// With per-processor timers, the signal may also be a poke (SIGUSR1) from another processor or the wakeup of a
+	// higher-priority task on this cluster, so always reschedule.
+#if defined( __U_MULTI__ ) && ! defined( __U_PROCESSOR_TIMER__ )
 	if ( cxtSwHandler )				// context-switch event ?
-#endif // __U_MULTI__
+#endif // __U_MULTI__ && ! __U_PROCESSOR_TIMER__
 	    // No need to send SIGUSR1 to system processor via context-switch handler just do the context switch.
 	    uThisTask().uYieldInvoluntary();
     } else {
@@ -285,6 +524,21 @@ uEventListPop::~uEventListPop() {
 } // uEventListPop::~uEventListPop
 
 
+#if defined( __U_PROCESSOR_TIMER__ )
+void uEventListPop::wakeup( uCluster &cluster ) {
+    for ( unsigned int i = 0; i < wakeupCnt; i += 1 ) {
+      if ( wakeupList[i] == &cluster ) return;		// already recorded ?
+    } // for
+    if ( wakeupCnt == WakeupMax ) {			// no room ? => poke now, event lock is not held
+	cluster.processorPoke();
+    } else {
+	wakeupList[wakeupCnt] = &cluster;
+	wakeupCnt += 1;
+    } // if
+} // uEventListPop::wakeup
+#endif // __U_PROCESSOR_TIMER__
+
+
 bool uEventListPop::operator>>( uEventNode *&node ) {
 #ifdef __U_DEBUG_H__
     char buf[1024];
@@ -293,9 +547,9 @@ bool uEventListPop::operator>>( uEventNode *&node ) {
 
     events->eventLock.acquire_( true );
 
-    node = events->eventlist.head();			// get event at the start of the list with the shortest time delay
+    node = events->dequeue( currTime );			// get event with the shortest time delay that has expired
 
-  if ( ! node ) {					// no events ?
+  if ( ! node ) {					// no expired events ?
 	events->eventLock.release_( true );
 	return false;
     } // if
@@ -304,29 +558,18 @@ bool uEventListPop::operator>>( uEventNode *&node ) {
     uDebugPrtBuf( buf, "(uEventListPop &)%p.>>, currTime:%lld node:%p %s alarm:%lld period:%lld\n", this, currTime.nanoseconds(), node, node->task != NULL ? node->task->getName() : "*noname*", node->alarm.nanoseconds(), node->period.nanoseconds() );
 #endif // __U_DEBUG_H__
 
-  if ( node->alarm > currTime ) {			// event time delay greater than the start time for the iteration
-	events->eventLock.release_( true );
-	return false;
-    } // if
-
-    events->eventlist.remove( node );
-
     // If the popped event is periodic, reinsert for next period.
     if ( node->period != 0 ) {
 	node->alarm = currTime + node->period;		// reset time for next alarm
-
-	uEventNode *event;
-	// May have to order identical timed elements by priority (to keep up the real-time spirit)
-	for ( uSeqIter<uEventNode> iter( events->eventlist ); iter >> event && event->alarm <= node->alarm; );
-	events->eventlist.insertBef( node, event );	// insert into sorted position in list
+	events->insert( *node );			// identical alarms stay FIFO
     } // if
 
     uCxtSwtchHndlr *cxtSwEvent = dynamic_cast<uCxtSwtchHndlr *>(node->sigHandler);
     if ( cxtSwEvent != NULL ) {				// ContextSwitch event ?
 #if defined( __U_MULTI__ )
-	if ( &cxtSwEvent->processor == uKernelModule::systemProcessor ) {
+	if ( &cxtSwEvent->processor == &uThisProcessor() ) { // always with per-processor timers
 #endif // ! __U_MULTI__
-	    // Defer ContextSwitch for system processor until after all events processed so SIGUSR1 not delivered during
+	    // Defer ContextSwitch for this processor until after all events processed so SIGUSR1 not delivered during
 	    // event processing.
 	    assert( cxtSwHandler == NULL );
 	    cxtSwHandler = node->sigHandler;
@@ -344,14 +587,20 @@ bool uEventListPop::operator>>( uEventNode *&node ) {
 	// lower-priority tasks execuing on processors in the cluster.  As a side effect, if the current task has the
 	// same priority as the task on the front of the ready queue, the current task is preempted even if it has only
 	// just started execution.
-#if defined( __U_MULTI__ )
+#if defined( __U_PROCESSOR_TIMER__ )
+	uCluster *cluster = NULL;
+	if ( dynamic_cast<uWakeupHndlr *>(node->sigHandler) != NULL ) { // uWakeupHndlr event ?
+	    assert( node->task != NULL );
+	    cluster = node->task->currCluster;		// read before the handler makes the task ready
+	} // if
+#elif defined( __U_MULTI__ )
 	if ( dynamic_cast<uWakeupHndlr *>(node->sigHandler) != NULL ) { // uWakeupHndlr event ?
 	    assert( node->task != NULL );
 	    if ( ! node->task->currCluster->wakeupList.listed() ) { // already on list ?
 		wakeupList.addTail( &(node->task->currCluster->wakeupList) ); // defer until destructor
 	    } // if
 	} // if
-#endif // __U_MULTI__
+#endif // __U_PROCESSOR_TIMER__ / __U_MULTI__
 
 	if ( node->executeLocked ) {			// should handler be called with lock
 	    node->sigHandler->handler();		// invoke the handler code for the event
@@ -360,6 +609,9 @@ bool uEventListPop::operator>>( uEventNode *&node ) {
 	    events->eventLock.release_( true );
 	    node->sigHandler->handler();		// invoke the handler code for the event
 	} // if
+#if defined( __U_PROCESSOR_TIMER__ )
+	if ( cluster != NULL ) wakeup( *cluster );	// defer until destructor
+#endif // __U_PROCESSOR_TIMER__
     } // if
 
     return true;
@@ -57,6 +57,8 @@ class uEventNode : public uSeqable {
     uBaseTask *task;					// task who created event
     uSignalHandler *sigHandler;				// action to perform when timer expires
     bool executeLocked;					// true => handler executed with uEventlock acquired
+    unsigned int bucket;				// timing-wheel bucket containing node
+    uEventList *list;					// event list node last added to
 
     void createEventNode( uBaseTask *task, uSignalHandler *sig, uTime alarm, uDuration period );
     uEventNode();
@@ -77,18 +79,50 @@ class uEventList {
     friend class uCondLock;				// access: addEvent, removeEvent
     friend class UPP::uNBIO;				// access: addEvent, removeEvent, uNextAlarm
     friend class uBaseTask;				// access: addEvent
-    friend class UPP::uKernelBoot;			// access: uEventList
+    friend class UPP::uKernelBoot;			// access: uEventList, createTimer
     friend class uProcessor;				// access: uEventList
-    friend class uEventListPop;				// access: eventLock, eventlist
+    friend class uEventListPop;				// access: eventLock, dequeue, insert, nextAlarm
     friend class uEventNode;				// access: addEvent, removeEvent
+    friend class uProcessor;				// access: nextRetired, retire
+    friend void *uKernelModule::startThread( void *p ); // access: createTimer
   protected:
-    uSpinLock eventLock;				// protect EventQueue
-    uSequence<uEventNode> eventlist;			// event list
-
+    // Events are kept in a hierarchical timing wheel: WheelLevels levels of WheelSlots buckets, where a level-k bucket
+    // spans WheelSlots^k ticks of 2^TickShift nanoseconds. An event is filed at the level of the highest tick digit in
+    // which its alarm differs from the wheel time, so every event at level k expires before every event at level k+1.
+    // Level-0 buckets are sorted by alarm; higher-level buckets are unordered and cascade down as the wheel time
+    // reaches them. Hence, insert and remove are O(1) and the next alarm is found from the occupancy bitmaps.
+    enum { WheelBits = 6, WheelSlots = 1 << WheelBits, WheelLevels = 8, TickShift = 20 };
+
+    uAlignedSpinLock eventLock;				// protect EventQueue
+    uSequence<uEventNode> wheel[WheelLevels * WheelSlots]; // timing-wheel buckets
+    unsigned long long int occupied[WheelLevels];	// bit set => bucket at that level is not empty
+    unsigned long long int wheelTime;			// current tick, all buckets are filed relative to it
+    unsigned int count;					// number of events in the wheel
+#if defined( __U_PROCESSOR_TIMER__ )
+    uProcessor *owner;					// processor signalled by timer, NULL => processor not started or deleted
+    timer_t timer;					// POSIX timer signalling owner's kernel thread
+    uEventList *nextRetired;				// link for pool of event lists from deleted processors
+#endif // __U_PROCESSOR_TIMER__
+
+    uEventList();
     virtual ~uEventList() {}
 
-    void addEvent( uEventNode &newAlarm, bool block = false );
-    void removeEvent( uEventNode &event );
+    static unsigned long long int tick( uTime time );	// convert time to wheel ticks
+    void file( uEventNode &event );			// place event in bucket relative to wheel time
+    void insert( uEventNode &event );			// add event to wheel
+    void unlink( uEventNode &event );			// remove event from wheel
+    int firstBucket() const;				// bucket with earliest events, -1 => empty
+    unsigned long long int bucketTick( int bucket ) const; // first tick covered by bucket
+    uTime nextAlarm() const;				// earliest alarm or lower bound of it, 0 => empty
+    void advance( unsigned long long int to );		// move wheel time forward and cascade buckets
+    uEventNode *dequeue( uTime now );			// remove earliest event with alarm <= now
+
+    bool addEvent( uEventNode &newAlarm, bool block = false );
+    bool removeEvent( uEventNode &event );
+#if defined( __U_PROCESSOR_TIMER__ )
+    void createTimer( uProcessor &processor );		// called by processor's kernel thread
+    void retire( uEventList &to );			// move events to another list when processor deleted
+#endif // __U_PROCESSOR_TIMER__
 
 #if ! defined( __U_MULTI__ )
     bool userEventPresent();
@@ -105,7 +139,16 @@ class uEventList {
 
 class uEventListPop {
     uEventList *events;					// list of handler events
+#if defined( __U_PROCESSOR_TIMER__ )
+    // Processors roll forward concurrently, so the single wakeup link in each cluster cannot be shared among them;
+    // each iterator keeps its own small set of clusters instead.
+    enum { WakeupMax = 8 };
+    uCluster *wakeupList[WakeupMax];			// clusters with wakeups
+    unsigned int wakeupCnt;
+    void wakeup( uCluster &cluster );
+#else
     uClusterSeq wakeupList;				// list of clusters with wakeups
+#endif // __U_PROCESSOR_TIMER__
     uTime currTime;					// time iteration starts
     uSignalHandler *cxtSwHandler;			// ContextSwitch for system processor
     bool inKernel;					// processing events from the kernel
@@ -123,7 +123,7 @@ static int *my_errno_location() {
 #endif // ! __U_ERRNO_FUNC__
 
 
-void uBaseCoroutine::contextSw() {			// switch between a task and the kernel
+void uBaseCoroutine::contextSw( uBaseTask *next ) {	// switch between a task and the kernel, or directly to next task
     uBaseCoroutine &coroutine = uThisCoroutine();	// optimization
     uBaseTask &currTask = uThisTask();
 
@@ -145,7 +145,12 @@ void uBaseCoroutine::contextSw() {			// switch between a task and the kernel
 #endif // ! __U_ERRNO_FUNC__
     coroutine.save();					// save user specified contexts
 
-    uSwitch( coroutine.context, context );		// context switch to kernel
+    if ( next == NULL ) {
+	uSwitch( coroutine.context, context );		// context switch to kernel
+    } else {
+	THREAD_SETMEM( activeTask, next );		// kernel does not run, so set next task
+	uSwitch( coroutine.context, next->currCoroutine->context ); // context switch to next task
+    } // if
 
     coroutine.restore();				// restore user specified contexts
 
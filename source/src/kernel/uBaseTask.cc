@@ -55,6 +55,7 @@ void uBaseTask::createTask( uCluster &cluster ) {
     acceptedCall = NULL;				// no accepted mutex entry yet
     priority = activePriority = 0;
     inheritTask = this;
+    readyIndex = 0;
 
     // exception handling
 
@@ -107,6 +108,28 @@ void uBaseTask::wake() {
 } // uBaseTask::wake
 
 
+void uBaseTask::wake( uBaseTaskSeq &readyTasks ) {	// tasks linked through readyRef
+    // Tasks released together by a broadcast-style operation are normally on the same cluster, so they are moved to
+    // its ready queue with a single lock acquisition. Bound tasks and tasks on other clusters are woken individually.
+
+  if ( readyTasks.empty() ) return;
+    uCluster *cluster = readyTasks.head()->task().currCluster;
+    uBaseTaskSeq batch;
+    unsigned int n = 0;
+    for ( uBaseTaskDL *node = readyTasks.dropHead(); node != NULL; node = readyTasks.dropHead() ) {
+	uBaseTask &task = node->task();
+	if ( task.currCluster == cluster && &task.bound == NULL ) {
+	    task.setState( Ready );			// task is marked available for execution
+	    batch.addTail( node );
+	    n += 1;
+	} else {
+	    task.wake();
+	} // if
+    } // for
+    if ( n != 0 ) cluster->makeTaskReady( batch, n );	// put the tasks on the ready queue of the cluster
+} // uBaseTask::wake
+
+
 uBaseTask::uBaseTask( uCluster &cluster ) : uBaseCoroutine( cluster.getStackSize() ), clusterRef( *this ), readyRef( *this ), entryRef( *this ), mutexRef( *this ), bound( *(uProcessor *)0 ) {
     createTask( cluster );
 } // uBaseTask::uBaseTask
@@ -160,7 +183,7 @@ uCluster &uBaseTask::migrate( uCluster &cluster ) {
 #endif // __U_LOCALDEBUGGER_H__
 
     // swapcontext saves and restores the signal mask while uC++ context switch does not.
-#if defined( __U_MULTI__ ) && defined( __U_SWAPCONTEXT__ )
+#if defined( __U_MULTI__ ) && defined( __U_SWAPCONTEXT__ ) && ! defined( __U_PROCESSOR_TIMER__ )
     // when stepping off the system cluster, the SIGALRM must be reset to blocked
     if ( &prevCluster == uKernelModule::systemCluster ) {
  	sigset_t new_mask;
@@ -170,13 +193,13 @@ uCluster &uBaseTask::migrate( uCluster &cluster ) {
  	    uAbort( "internal error, sigprocmask" );
  	} // if
     } // if
-#endif // __U_MULTI__ && __U_SWAPCONTEXT__
+#endif // __U_MULTI__ && __U_SWAPCONTEXT__ && ! __U_PROCESSOR_TIMER__
 
     // Force a context switch so the task is scheduled on the new cluster.
 
     yield();
 
-#if defined( __U_MULTI__ ) && defined( __U_SWAPCONTEXT__ )
+#if defined( __U_MULTI__ ) && defined( __U_SWAPCONTEXT__ ) && ! defined( __U_PROCESSOR_TIMER__ )
     // when stepping onto the system cluster, the SIGALRM must reset to unblocked
     if ( &cluster == uKernelModule::systemCluster ) {
 	sigset_t new_mask;
@@ -186,7 +209,7 @@ uCluster &uBaseTask::migrate( uCluster &cluster ) {
 	    uAbort( "internal error, sigprocmask" );
 	} // if
     } // if
-#endif // __U_MULTI__ && __U_SWAPCONTEXT__
+#endif // __U_MULTI__ && __U_SWAPCONTEXT__ && ! __U_PROCESSOR_TIMER__
 
 #if defined( __U_DEBUG__ ) && defined( __U_MULTI__ )
     assert( before != THREAD_GETMEM( This ) );
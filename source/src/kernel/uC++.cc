@@ -44,7 +44,9 @@
 #include <exception>
 #include <dlfcn.h>
 #include <cstdio>
+#include <cstring>					// memset
 #include <unistd.h>					// _exit
+#include <sys/syscall.h>				// SYS_sched_yield
 #if defined( __solaris__ )
 #include <ieeefp.h>					// floating-point exceptions
 #else
@@ -60,40 +62,85 @@ using namespace UPP;
 
 
 #ifdef __U_STATISTICS__
-// Kernel, signed because of the atomic inc/dec
-int Statistics::ready_queue = 0, Statistics::spins = 0, Statistics::spin_sched = 0, Statistics::mutex_queue = 0,
-    Statistics::owner_lock_queue = 0, Statistics::adaptive_lock_queue = 0, Statistics::io_lock_queue = 0,
-    Statistics::uSpinLocks = 0, Statistics::uLocks = 0, Statistics::uOwnerLocks = 0, Statistics::uCondLocks = 0, Statistics::uSemaphores = 0, Statistics::uSerials = 0;
-
-// I/O statistics
-unsigned int Statistics::select_syscalls = 0, Statistics::select_errors = 0, Statistics::select_eintr = 0;
-unsigned int Statistics::select_events = 0, Statistics::select_nothing = 0, Statistics::select_blocking = 0, Statistics::select_pending = 0;
-unsigned int Statistics::select_maxFD = 0;
-unsigned int Statistics::accept_syscalls = 0, Statistics::accept_errors = 0;
-unsigned int Statistics::read_syscalls = 0, Statistics::read_errors = 0, Statistics::read_eagain = 0, Statistics::read_chunking = 0, Statistics::read_bytes = 0;
-unsigned int Statistics::write_syscalls = 0, Statistics::write_errors = 0, Statistics::write_eagain = 0, Statistics::write_bytes = 0;
-unsigned int Statistics::sendfile_syscalls = 0, Statistics::sendfile_errors = 0, Statistics::sendfile_eagain = 0, Statistics::first_sendfile = 0, Statistics::sendfile_yields = 0;
-
-unsigned int Statistics::iopoller_exchange = 0, Statistics::iopoller_spin = 0;
-unsigned int Statistics::signal_alarm = 0, Statistics::signal_usr1 = 0;
-
-// Scheduling statistics
-unsigned int Statistics::roll_forward = 0;
-unsigned int Statistics::user_context_switches = 0;
-unsigned int Statistics::kernel_thread_yields = 0, Statistics::kernel_thread_pause = 0;
-unsigned int Statistics::wake_processor = 0;
-unsigned int Statistics::events = 0, Statistics::setitimer = 0;
+Statistics::Block Statistics::bootBlock;
+Statistics::Block *volatile Statistics::blocks = NULL;
+
+unsigned int Statistics::select_maxFD = 0, Statistics::select_pending = 0;
 
 // Print statistics
 bool Statistics::prtSigterm = false;
 bool Statistics::prtHeapterm = false;
 
+
+Statistics::Block *UPP::Statistics::allocate() {
+    for ( Block *block = blocks; block != NULL; block = block->next ) { // reuse block of a deleted processor
+	if ( ! block->inUse && uCompareAssign( block->inUse, false, true ) ) return block; // counts are kept
+    } // for
+
+    Block *block = (Block *)::memalign( __alignof__( Block ), sizeof( Block ) ); // separate cache lines
+    memset( block, 0, sizeof( Block ) );
+    block->inUse = true;
+    Block *head;
+    do {						// blocks are never removed so the push is ABA free
+	head = blocks;
+	block->next = head;
+    } while ( ! uCompareAssign( blocks, head, block ) );
+    return block;
+} // UPP::Statistics::allocate
+
+
+void UPP::Statistics::release( Block *block ) {
+    block->inUse = false;
+} // UPP::Statistics::release
+
+
+void UPP::Statistics::snapshot( Counters &counts ) {
+    // Counters only contains int-sized fields, so the blocks are summed as arrays. Fields are read without locking, so
+    // a snapshot taken while counting is in progress is only approximately consistent across fields.
+    enum { Fields = sizeof( Counters ) / sizeof( unsigned int ) };
+    unsigned int *sum = (unsigned int *)&counts;
+    const unsigned int *boot = (const unsigned int *)&bootBlock.counters;
+    for ( unsigned int f = 0; f < Fields; f += 1 ) sum[f] = boot[f];
+    for ( Block *block = blocks; block != NULL; block = block->next ) {
+	const volatile unsigned int *add = (const volatile unsigned int *)&block->counters;
+	for ( unsigned int f = 0; f < Fields; f += 1 ) sum[f] += add[f];
+    } // for
+} // UPP::Statistics::snapshot
+
+
+void UPP::Statistics::delta( Counters &last, Counters &diff ) {
+    enum { Fields = sizeof( Counters ) / sizeof( unsigned int ) };
+    Counters curr;
+    snapshot( curr );
+    unsigned int *d = (unsigned int *)&diff, *l = (unsigned int *)&last, *c = (unsigned int *)&curr;
+    for ( unsigned int f = 0; f < Fields; f += 1 ) {
+	d[f] = c[f] - l[f];				// modulo arithmetic also handles gauges going down
+	l[f] = c[f];
+    } // for
+} // UPP::Statistics::delta
+
+
+void UPP::Statistics::finishup() {
+    // All processors are deleted, so the blocks are folded into the boot block for printing at exit, and freed.
+    Counters counts;
+    snapshot( counts );
+    bootBlock.counters = counts;
+    for ( Block *block; ( block = blocks ) != NULL; ) {
+	blocks = block->next;
+	free( block );
+    } // for
+} // UPP::Statistics::finishup
+
+
 void UPP::Statistics::print() {
     uStatistics();					// user specified statistics
 
     char helpText[512];
     int len;
 
+    Counters counts;
+    snapshot( counts );
+
     len = snprintf( helpText, 512,
 		    "\nKernel statistics:\n"
 		    "  locks:"
@@ -108,16 +155,16 @@ void UPP::Statistics::print() {
 		    "  signal:"
 		    " alarm %d"
 		    " / usr1 %d\n",
-		    Statistics::uSpinLocks,
-		    Statistics::spins,
-		    Statistics::spin_sched,
-		    Statistics::uLocks,
-		    Statistics::uOwnerLocks,
-		    Statistics::uCondLocks,
-		    Statistics::uSemaphores,
-		    Statistics::uSerials,
-		    Statistics::signal_alarm,
-		    Statistics::signal_usr1 );
+		    counts.uSpinLocks,
+		    counts.spins,
+		    counts.spin_sched,
+		    counts.uLocks,
+		    counts.uOwnerLocks,
+		    counts.uCondLocks,
+		    counts.uSemaphores,
+		    counts.uSerials,
+		    counts.signal_alarm,
+		    counts.signal_usr1 );
     uDebugWrite( STDOUT_FILENO, helpText, len );
 
     len = snprintf( helpText, 512,
@@ -134,16 +181,16 @@ void UPP::Statistics::print() {
 		    "  accept:"
 		    " calls %d"
 		    " / errors %d\n",
-		    Statistics::select_syscalls,
-		    Statistics::select_errors,
-		    Statistics::select_eintr,
-		    Statistics::select_events,
-		    Statistics::select_nothing,
-		    (Statistics::select_syscalls != 0 ? Statistics::select_events / Statistics::select_syscalls : 0 ),
-		    Statistics::select_blocking,
-		    Statistics::select_maxFD,
-		    Statistics::accept_syscalls,
-		    Statistics::accept_errors );
+		    counts.select_syscalls,
+		    counts.select_errors,
+		    counts.select_eintr,
+		    counts.select_events,
+		    counts.select_nothing,
+		    (counts.select_syscalls != 0 ? counts.select_events / counts.select_syscalls : 0 ),
+		    counts.select_blocking,
+		    select_maxFD,
+		    counts.accept_syscalls,
+		    counts.accept_errors );
     uDebugWrite( STDOUT_FILENO, helpText, len );
 
     len = snprintf( helpText, 512,
@@ -158,15 +205,15 @@ void UPP::Statistics::print() {
 		    " / errors %d"
 		    " / eagain %d"
 		    " / bytes %d\n",
-		    Statistics::read_syscalls,
-		    Statistics::read_errors,
-		    Statistics::read_eagain,
-		    Statistics::read_chunking,
-		    Statistics::read_bytes,
-		    Statistics::write_syscalls,
-		    Statistics::write_errors,
-		    Statistics::write_eagain,
-		    Statistics::write_bytes );
+		    counts.read_syscalls,
+		    counts.read_errors,
+		    counts.read_eagain,
+		    counts.read_chunking,
+		    counts.read_bytes,
+		    counts.write_syscalls,
+		    counts.write_errors,
+		    counts.write_eagain,
+		    counts.write_bytes );
     uDebugWrite( STDOUT_FILENO, helpText, len );
 
     len = snprintf( helpText, 512,
@@ -176,34 +223,53 @@ void UPP::Statistics::print() {
 		    " / eagain %d"
 		    " / yields %d"
 		    " / first call completion %d\n"
+		    "  io_uring:"
+		    " submissions %d"
+		    " / enters %d"
+		    " / completions %d\n"
 		    "  iopoller:"
 		    " exchanges %d"
 		    " / spins %d\n",
-		    Statistics::sendfile_syscalls,
-		    Statistics::sendfile_errors,
-		    Statistics::sendfile_eagain,
-		    Statistics::sendfile_yields,
-		    Statistics::first_sendfile,
-		    Statistics::iopoller_exchange,
-		    Statistics::iopoller_spin );
+		    counts.sendfile_syscalls,
+		    counts.sendfile_errors,
+		    counts.sendfile_eagain,
+		    counts.sendfile_yields,
+		    counts.first_sendfile,
+		    counts.uring_submissions,
+		    counts.uring_enters,
+		    counts.uring_completions,
+		    counts.iopoller_exchange,
+		    counts.iopoller_spin );
     uDebugWrite( STDOUT_FILENO, helpText, len );
 
     len = snprintf( helpText, 512,
 		    "\nScheduler statistics:\n"
 		    "  roll forward: %d\n"
-		    "  user context switches: %d\n"
+		    "  user context switches: %d"
+		    " / direct %d"
+		    " / hand-off %d\n"
 		    "  kernel thread: yields %d"
 		    " / pause %d"
-		    " / processor wake %d\n"
+		    " / processor wake %d"
+		    " / work steals %d\n"
+		    "  processor wakeups: productive %d"
+		    " / spurious %d"
+		    " / while spinning %d\n"
 		    "  events %d"
 		    " / setitimer %d\n",
-		    Statistics::roll_forward,
-		    Statistics::user_context_switches,
-		    Statistics::kernel_thread_yields,
-		    Statistics::kernel_thread_pause,
-		    Statistics::wake_processor,
-		    Statistics::events,
-		    Statistics::setitimer );
+		    counts.roll_forward,
+		    counts.user_context_switches,
+		    counts.direct_switches,
+		    counts.handoff_switches,
+		    counts.kernel_thread_yields,
+		    counts.kernel_thread_pause,
+		    counts.wake_processor,
+		    counts.work_steals,
+		    counts.wakeup_productive,
+		    counts.wakeup_spurious,
+		    counts.wakeup_spin,
+		    counts.events,
+		    counts.setitimer );
     uDebugWrite( STDOUT_FILENO, helpText, len );
 } // UPP::Statistics::print
 #endif // __U_STATISTICS__
@@ -398,7 +464,7 @@ void uBaseSpinLock::acquire_( bool rollforward ) {
 #endif
 	    if ( uKernelModule::globalSpinAbort ) _exit( EXIT_FAILURE ); // close down in progress, shutdown immediately!
 #ifdef __U_STATISTICS__
-	    uFetchAdd( Statistics::spins, 1 );
+	    uFetchAdd( Statistics::counters().spins, 1 );
 #endif // __U_STATISTICS__
 	} // for
 	spin += spin;					// powers of 2
@@ -406,7 +472,7 @@ void uBaseSpinLock::acquire_( bool rollforward ) {
 	    spin = SPIN_START;				// prevent overflow
 //	    sched_yield();				// release CPU so someone else can execute
 #ifdef __U_STATISTICS__
-	    uFetchAdd( Statistics::spin_sched, 1 );
+	    uFetchAdd( Statistics::counters().spin_sched, 1 );
 #endif // __U_STATISTICS__
 	} // if
 	THREAD_GETMEM( This )->disableIntSpinLock();
@@ -448,6 +514,122 @@ bool uBaseSpinLock::tryacquire() {
 } // uBaseSpinLock::tryacquire
 
 
+void uMCSLock::acquire() {
+    // Interrupts stay disabled while queued, otherwise the lock could be handed to a waiter that has been time sliced
+    // and every waiter behind it would spin until it runs again.  The lock is still handed to a waiter whose kernel
+    // thread the OS has descheduled when there are more processors than CPUs, so a long wait releases the CPU.
+
+    enum { SPIN_YIELD = 4 * 1024 };			// spins before releasing the CPU
+
+    THREAD_GETMEM( This )->disableIntSpinLock();
+
+#ifdef __U_MULTI__
+    Node *const Waiting = (Node *)1;
+    int spin = 0;
+
+    for ( ;; ) {
+	Node *prev = lock.tail;
+	if ( prev == NULL ) {				// lock appears free ?
+	  if ( uCompareAssign( lock.tail, (Node *)NULL, &lock ) ) break; // lock node represents the holder
+	} else {
+	    Node node;					// waiter node on this stack
+	    node.tail = Waiting;
+	    node.next = NULL;
+	    if ( uCompareAssign( lock.tail, prev, &node ) ) { // in line ?
+		prev->next = &node;			// link behind the predecessor (or the holder's lock node)
+		while ( node.tail == Waiting ) {	// spin on own node until granted
+#if defined( __i386__ ) || defined( __x86_64__ )
+		    asm volatile( "pause" );
+#endif
+		    if ( uKernelModule::globalSpinAbort ) _exit( EXIT_FAILURE ); // close down in progress, shutdown immediately!
+#ifdef __U_STATISTICS__
+		    uFetchAdd( Statistics::counters().spins, 1 );
+#endif // __U_STATISTICS__
+		    spin += 1;
+		    if ( spin > SPIN_YIELD ) {
+			spin = 0;
+			syscall( SYS_sched_yield );		// release CPU so the holder or granted waiter can execute, bypassing uC++ sched_yield
+#ifdef __U_STATISTICS__
+			uFetchAdd( Statistics::counters().spin_sched, 1 );
+#endif // __U_STATISTICS__
+		    } // if
+		} // while
+
+		// Lock granted, so move the successor link from the stack node to the lock node before returning.
+		Node *succ = node.next;
+		if ( succ == NULL ) {
+		    lock.next = NULL;
+		    if ( ! uCompareAssign( lock.tail, &node, &lock ) ) { // another waiter queued behind this node ?
+			while ( ( succ = node.next ) == NULL ) { // wait for it to link itself
+#if defined( __i386__ ) || defined( __x86_64__ )
+			    asm volatile( "pause" );
+#endif
+			} // while
+			lock.next = succ;
+		    } // if
+		} else {
+		    lock.next = succ;
+		} // if
+		break;
+	    } // if
+	} // if
+    } // for
+#else
+#ifdef __U_DEBUG__
+    if ( lock.tail != NULL ) {				// locked ?
+	uAbort( "(uMCSLock &)%p.acquire() : internal error, attempt to multiply acquire spin lock by same task.", this );
+    } // if
+#endif // __U_DEBUG__
+    lock.tail = &lock;					// lock
+#endif // __U_MULTI__
+    asm( "" : : : "memory" );				// prevent code movement across barrier
+} // uMCSLock::acquire
+
+
+bool uMCSLock::tryacquire() {
+    THREAD_GETMEM( This )->disableIntSpinLock();
+
+#ifdef __U_MULTI__
+    if ( lock.tail == NULL && uCompareAssign( lock.tail, (Node *)NULL, &lock ) ) { // get the lock ?
+	return true;
+    } else {
+	THREAD_GETMEM( This )->enableIntSpinLock();
+	return false;
+    } // if
+#else
+#ifdef __U_DEBUG__
+    if ( lock.tail != NULL ) {				// locked ?
+	uAbort( "(uMCSLock &)%p.tryacquire() : internal error, attempt to multiply acquire spin lock by same task.", this );
+    } // if
+#endif // __U_DEBUG__
+    lock.tail = &lock;					// lock
+    return true;
+#endif // __U_MULTI__
+} // uMCSLock::tryacquire
+
+
+void uMCSLock::release() {
+    asm( "" : : : "memory" );				// prevent code movement across barrier
+    assert( lock.tail != NULL );
+#ifdef __U_MULTI__
+    Node *succ = lock.next;
+    if ( succ == NULL ) {				// no known waiter ?
+	if ( uCompareAssign( lock.tail, &lock, (Node *)NULL ) ) goto released;
+	while ( ( succ = lock.next ) == NULL ) {	// a waiter is linking itself
+#if defined( __i386__ ) || defined( __x86_64__ )
+	    asm volatile( "pause" );
+#endif
+	} // while
+    } // if
+    succ->tail = NULL;					// hand over the lock
+  released:
+#else
+    lock.tail = NULL;					// unlock
+#endif // __U_MULTI__
+    THREAD_GETMEM( This )->enableIntSpinLock();
+} // uMCSLock::release
+
+
 //######################### uLock #########################
 
 
@@ -493,17 +675,35 @@ void uOwnerLock::add_( uBaseTask &task ) {		// used by uCondLock::signal
 } // uOwnerLock::add_
 
 
-void uOwnerLock::release_() {				// used by uCondLock::wait
+void uOwnerLock::add_( uSequence<uBaseTaskDL> &tasks ) { // used by uCondLock::broadcast
     spinLock.acquire();
+    if ( owner_ == NULL ) {				// lock free ?
+	owner_ = &(tasks.dropHead()->task());		// first task becomes owner
+	count = 1;
+	owner_->wake();					// restart new owner
+    } // if
+    waiting.transfer( tasks );				// move remaining tasks to owner lock list
+    spinLock.release();
+} // uOwnerLock::add_
+
+
+uBaseTask *uOwnerLock::release_() {			// used by uCondLock::wait
+    // The new owner is not woken here because the caller is about to block, and passes the new owner to the scheduler,
+    // which restarts it after the caller is blocked.
+
+    spinLock.acquire();
+    uBaseTask *next;
     if ( ! waiting.empty() ) {				// waiting tasks ?
 	owner_ = &(waiting.dropHead()->task());		// remove task at head of waiting list and make new owner
 	count = 1;
-	owner_->wake();					// restart new owner
+	next = owner_;					// new owner restarted by caller
     } else {
 	owner_ = NULL;					// release, no owner
 	count = 0;
+	next = NULL;
     } // if
     spinLock.release();
+    return next;
 } // uOwnerLock::release_
 
 
@@ -532,11 +732,11 @@ void uOwnerLock::acquire() {
 	if ( owner_ != NULL ) {				// but if lock in use
 	    waiting.addTail( &(task.entryRef) );	// suspend current task
 #ifdef __U_STATISTICS__
-	    uFetchAdd( Statistics::owner_lock_queue, 1 );
+	    uFetchAdd( Statistics::counters().owner_lock_queue, 1 );
 #endif // __U_STATISTICS__
 	    uProcessorKernel::schedule( &spinLock );	// atomically release owner spin lock and block
 #ifdef __U_STATISTICS__
-	    uFetchAdd( Statistics::owner_lock_queue, -1 );
+	    uFetchAdd( Statistics::counters().owner_lock_queue, -1 );
 #endif // __U_STATISTICS__
 	    // owner_ and count set in release
 	    return;
@@ -643,8 +843,12 @@ void uCondLock::wait( uOwnerLock &lock ) {
     waiting.addTail( &(task.entryRef) );		// queue current task
     // Must add to the condition queue first before releasing the owner lock because testing for empty condition can
     // occur immediately after the owner lock is released.
-    lock.release_();					// release owner lock
-    uProcessorKernel::schedule( &spinLock );		// atomically release condition spin lock and block
+    uBaseTask *next = lock.release_();			// release owner lock
+    if ( next != NULL ) {				// new owner ?
+	uProcessorKernel::schedule( &spinLock, next );	// atomically release condition spin lock, block and restart new owner
+    } else {
+	uProcessorKernel::schedule( &spinLock );	// atomically release condition spin lock and block
+    } // if
     // spin released by schedule, owner lock is acquired when task restarts
 //    assert( &task == lock.owner() );
     lock.count = prevcnt;				// reestablish lock's recursive count after blocking
@@ -681,8 +885,12 @@ bool uCondLock::wait( uOwnerLock &lock, uTime time ) {
     waiting.addTail( &(task.entryRef) );		// queue current task
     // Must add to the condition queue first before releasing the owner lock because testing for empty condition can
     // occur immediately after the owner lock is released.
-    lock.release_();					// release owner lock
-    uProcessorKernel::schedule( &spinLock );		// atomically release owner spin lock and block
+    uBaseTask *next = lock.release_();			// release owner lock
+    if ( next != NULL ) {				// new owner ?
+	uProcessorKernel::schedule( &spinLock, next );	// atomically release condition spin lock, block and restart new owner
+    } else {
+	uProcessorKernel::schedule( &spinLock );	// atomically release condition spin lock and block
+    } // if
     // spin released by schedule, owner lock is acquired when task restarts
     assert( &task == lock.owner() );
     lock.count = prevcnt;				// reestablish lock's recursive count after blocking
@@ -724,16 +932,23 @@ void uCondLock::signal() {
 
 
 void uCondLock::broadcast() {
-    // It is impossible to chain the entire waiting list to the associated owner lock because each wait can be on a
-    // different owner lock. Hence, each task has to be individually processed to move it onto the correct owner lock.
+    // Each wait can be on a different owner lock, so the waiting list is chained to the owner locks in runs of tasks
+    // waiting on the same owner lock. Normally all tasks use the same owner lock, so the entire list is moved with one
+    // acquisition of that lock.
 
     uSequence<uBaseTaskDL> temp;
     spinLock.acquire();
     temp.transfer( waiting );
     spinLock.release();
     while ( ! temp.empty() ) {
-	uBaseTask &task = temp.dropHead()->task();	// remove task at head of waiting list
-	task.ownerLock->add_( task );			// restart it or chain to its owner lock
+	uOwnerLock *ownerLock = temp.head()->task().ownerLock;
+	uBaseTaskDL *last = temp.head();
+	for ( uBaseTaskDL *node = temp.succ( last ); node != NULL && node->task().ownerLock == ownerLock; node = temp.succ( node ) ) {
+	    last = node;
+	} // for
+	uSequence<uBaseTaskDL> run;
+	run.split( temp, last );			// remove run of tasks from head of waiting list
+	ownerLock->add_( run );				// restart first or chain all to their owner lock
     } // while
 } // uCondLock::broadcast
 
@@ -837,6 +1052,16 @@ int uBaseScheduleFriend::setBaseQueue( uBaseTask &task, int q ) {
     return task.setBaseQueue( q );
 } // uBaseScheduleFriend::setBaseQueue
 
+int uBaseScheduleFriend::getReadyIndex( uBaseTask &task ) {
+    return task.readyIndex;
+} // uBaseScheduleFriend::getReadyIndex
+
+int uBaseScheduleFriend::setReadyIndex( uBaseTask &task, int index ) {
+    int temp = task.readyIndex;
+    task.readyIndex = index;
+    return temp;
+} // uBaseScheduleFriend::setReadyIndex
+
 bool uBaseScheduleFriend::isEntryBlocked( uBaseTask &task ) const {
     return task.entryRef.listed();
 } // uBaseScheduleFriend::isEntryBlocked
@@ -851,7 +1076,7 @@ bool uBaseScheduleFriend::checkHookConditions( uBaseTask &task1, uBaseTask &task
 
 #ifdef KNOT
 void uDefaultScheduler::add( uBaseTaskDL *taskNode ) {
-    uFetchAdd( Statistics::ready_queue, 1 );
+    uFetchAdd( Statistics::counters().ready_queue, 1 );
     if ( taskNode->task().getActivePriorityValue() == 0 ) {
 	list.addTail( taskNode );
     } else {
@@ -1078,6 +1303,13 @@ void uKernelModule::uKernelModuleData::ctor() volatile {
 
     RFpending = RFinprogress = false;
 
+#if defined( __U_MULTI__ )
+    heapCache = NULL;
+#endif // __U_MULTI__
+#ifdef __U_STATISTICS__
+    statistics = &Statistics::bootBlock.counters;	// processor kernel threads switch to their own block
+#endif // __U_STATISTICS__
+
 #if defined( __ia64__ ) && ( defined( __linux__ ) || defined( __freebsd__ ) ) && defined( __U_MULTI__ )
     // set private memory pointer
     register volatile uKernelModule *thread_self asm( "r13" );
@@ -1094,15 +1326,15 @@ void uKernelModule::rollForward( bool inKernel ) {
 #endif // __U_DEBUG_H__
 
 #ifdef __U_STATISTICS__
-    uFetchAdd( UPP::Statistics::roll_forward, 1 );
+    uFetchAdd( UPP::Statistics::counters().roll_forward, 1 );
 #endif // __U_STATISTICS__
 
-#if defined( __U_MULTI__ )
+#if defined( __U_MULTI__ ) && ! defined( __U_PROCESSOR_TIMER__ )
     if ( &uThisProcessor() == uKernelModule::systemProcessor ) { // process events on event list
-#endif // __U_MULTI__
+#endif // __U_MULTI__ && ! __U_PROCESSOR_TIMER__
 	uEventNode *event;
-	for ( uEventListPop iter( *uKernelModule::systemProcessor->events, inKernel ); iter >> event; );
-#if defined( __U_MULTI__ )
+	for ( uEventListPop iter( *uThisProcessor().events, inKernel ); iter >> event; );
+#if defined( __U_MULTI__ ) && ! defined( __U_PROCESSOR_TIMER__ )
     } else {						// other processors only deal with context-switch
 	THREAD_SETMEM( RFinprogress, false );
 	if ( ! inKernel ) {				// not in kernel ?
@@ -1110,7 +1342,7 @@ void uKernelModule::rollForward( bool inKernel ) {
 	    uThisTask().uYieldInvoluntary();
 	} // if
     } // if
-#endif // __U_MULTI__
+#endif // __U_MULTI__ && ! __U_PROCESSOR_TIMER__
 
 #ifdef __U_DEBUG_H__
     uDebugPrtBuf( buffer, "rollForward, leaving, RFinprogress:%d\n", THREAD_GETMEM( RFinprogress ) );
@@ -1124,7 +1356,7 @@ void uKernelModule::rollForward( bool inKernel ) {
 namespace UPP {
     uSerial::uSerial( uBasePrioritySeq &entryList ) : entryList( entryList ) {
 #ifdef __U_STATISTICS__
-	uFetchAdd( UPP::Statistics::uSerials, 1 );
+	uFetchAdd( UPP::Statistics::counters().uSerials, 1 );
 #endif // __U_STATISTICS__
 	mask.clrAll();					// mutex members start closed
 	mutexOwner = &uThisTask();			// set the current mutex owner to the creating task
@@ -2161,6 +2393,30 @@ void uCondition::signal() {				// signal a condition
 } // uCondition::signal
 
 
+void uCondition::signalAll() {				// signal all tasks on a condition
+    // Equivalent to signalling until the condition is empty, but the tasks restart in FIFO order, and the checks are
+    // done once. Each signalled task still reacquires the mutex object in turn when the signaller leaves it.
+
+    if ( ! condQueue.empty() ) {
+	uBaseTask &task = uThisTask();			// optimization
+	UPP::uSerial &serial = task.getSerial();
+#ifdef __U_DEBUG__
+	uSignalCheck();
+#endif // __U_DEBUG__
+
+#ifdef __U_PROFILER__
+	if ( task.profileActive && uProfiler::uProfiler_registerSignal ) { // task registered for profiling ?
+	    (*uProfiler::uProfiler_registerSignal)( uProfiler::profilerInstance, *this, task, serial );
+	} // if
+#endif // __U_PROFILER__
+
+	uStack<uBaseTaskDL> reversed;
+	while ( ! condQueue.empty() ) reversed.add( condQueue.drop() );
+	while ( ! reversed.empty() ) serial.acceptSignalled.add( reversed.drop() ); // head of condition on top of stack
+    } // if
+} // uCondition::signalAll
+
+
 void uCondition::signalBlock() {			// signal a condition
     if ( ! condQueue.empty() ) {
 	uBaseTask &task = uThisTask();			// optimization
@@ -2281,12 +2537,17 @@ void UPP::uKernelBoot::startup() {
     uCluster::NBIO = new uNBIO;
 #endif // ! __U_MULTI__
 
+#if ! defined( __U_PROCESSOR_TIMER__ )
     uProcessor::events = new uEventList;
+#endif // ! __U_PROCESSOR_TIMER__
 
     // create system cluster: it is at a fixed address so storing the result is unnecessary.
 
     new( &uKernelModule::systemClusterStorage ) uCluster( *uKernelModule::systemScheduler, uDefaultStackSize(), "systemCluster" );
     new( &uKernelModule::systemProcessorStorage ) uProcessor( *uKernelModule::systemCluster, 1.0 );
+#if defined( __U_PROCESSOR_TIMER__ )
+    uKernelModule::systemProcessor->events->createTimer( *uKernelModule::systemProcessor ); // boot thread is system processor
+#endif // __U_PROCESSOR_TIMER__
 
     // create processor kernel
 
@@ -2477,7 +2738,9 @@ void UPP::uKernelBoot::finishup() {
     delete uProcessor::contextSwitchHandler;
 #endif // ! __U_MULTI__
 
+#if ! defined( __U_PROCESSOR_TIMER__ )
     delete uProcessor::events;
+#endif // ! __U_PROCESSOR_TIMER__
 
     // remove processor kernal coroutine with execution still pending
     delete THREAD_GETMEM( processorKernelStorage );
@@ -2513,6 +2776,9 @@ void UPP::uKernelBoot::finishup() {
     delete uKernelModule::globalProcessorLock;
     delete uKernelModule::globalAbortLock;
 
+#ifdef __U_STATISTICS__
+    Statistics::finishup();
+#endif // __U_STATISTICS__
     uHeapControl::finishup();
 } // uKernelBoot::finishup
 
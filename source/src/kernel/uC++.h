@@ -66,6 +66,20 @@
 #else
 #   include <sys/types.h>				// select, fd_set
 #endif // __solaris__ || __freebsd__
+#if defined( __linux__ )
+#   define __U_EPOLL__					// epoll available for non-blocking I/O
+#   include <sys/epoll.h>				// epoll_create1, epoll_ctl, epoll_pwait
+#   if defined( __has_include )
+#	if __has_include( <linux/io_uring.h> )
+#	    define __U_IOURING__				// io_uring available for completion-based I/O
+#	endif
+#   endif // __has_include
+#   if defined( __U_MULTI__ )
+#	define __U_PROCESSOR_TIMER__			// each processor has an event list and a timer signalling its kernel thread
+#	include <time.h>				// timer_create, timer_settime, timer_delete
+#	define __U_PROCESSOR_FUTEX__			// idle processors park on a futex rather than wait for SIGUSR1
+#   endif // __U_MULTI__
+#endif // __linux__
 
 // The GNU Libc defines C library functions with throw () when compiled under C++, to enable optimizations.  When uC++
 // overrides these functions, it must provide identical exception specifications.
@@ -167,32 +181,55 @@ extern "C" int malloc_stats_fd( int fd ) __THROW;
 #ifdef __U_STATISTICS__
 namespace UPP {
     struct Statistics {
-	// Kernel, signed because of the atomic inc/dec
-	static int ready_queue, spins, spin_sched, mutex_queue, owner_lock_queue, adaptive_lock_queue, io_lock_queue;
-	static int uSpinLocks, uLocks, uOwnerLocks, uCondLocks, uSemaphores, uSerials;
-
-	// I/O statistics
-	static unsigned int select_syscalls, select_errors, select_eintr;
-	static unsigned int select_events, select_nothing, select_blocking, select_pending;
-	static unsigned int select_maxFD;
-	static unsigned int accept_syscalls, accept_errors;
-	static unsigned int read_syscalls, read_errors, read_eagain, read_chunking, read_bytes;
-	static unsigned int write_syscalls, write_errors, write_eagain, write_bytes;
-	static unsigned int sendfile_syscalls, sendfile_errors, sendfile_eagain, first_sendfile, sendfile_yields;
-
-	static unsigned int iopoller_exchange, iopoller_spin;
-	static unsigned int signal_alarm, signal_usr1;
-
-	// Scheduling statistics
-	static unsigned int roll_forward;
-	static unsigned int user_context_switches;
-	static unsigned int kernel_thread_yields, kernel_thread_pause;
-	static unsigned int wake_processor;
-	static unsigned int events, setitimer;
+	// Counters are kept in a block per kernel thread and summed on reading, so counting on one processor never
+	// writes a cache line used by another. All counters are int sized so blocks can be summed as arrays.
+	struct Counters {
+	    // Kernel, signed because of the atomic inc/dec (a block may go negative; the sum is exact)
+	    int ready_queue, spins, spin_sched, mutex_queue, owner_lock_queue, adaptive_lock_queue, io_lock_queue;
+	    int uSpinLocks, uLocks, uOwnerLocks, uCondLocks, uSemaphores, uSerials;
+
+	    // I/O statistics
+	    unsigned int select_syscalls, select_errors, select_eintr;
+	    unsigned int select_events, select_nothing, select_blocking;
+	    unsigned int accept_syscalls, accept_errors;
+	    unsigned int read_syscalls, read_errors, read_eagain, read_chunking, read_bytes;
+	    unsigned int write_syscalls, write_errors, write_eagain, write_bytes;
+	    unsigned int sendfile_syscalls, sendfile_errors, sendfile_eagain, first_sendfile, sendfile_yields;
+	    unsigned int uring_submissions, uring_enters, uring_completions;
+
+	    unsigned int iopoller_exchange, iopoller_spin;
+	    unsigned int signal_alarm, signal_usr1;
+
+	    // Scheduling statistics
+	    unsigned int roll_forward;
+	    unsigned int user_context_switches, direct_switches, handoff_switches;
+	    unsigned int kernel_thread_yields, kernel_thread_pause;
+	    unsigned int wake_processor, work_steals;
+	    unsigned int wakeup_productive, wakeup_spurious, wakeup_spin; // outcome of processor pauses
+	    unsigned int events, setitimer;
+	}; // Counters
+
+	struct Block {					// cache-line aligned, never freed so a stale pointer stays valid
+	    Counters counters;
+	    Block *next;				// list of all blocks
+	    volatile bool inUse;			// owned by a processor
+	} __attribute__(( aligned (128) ));
+
+	static Block bootBlock;				// boot kernel thread, and uniprocessor
+	static Block *volatile blocks;			// blocks of multiprocessor processors
+
+	// Gauges, last value written
+	static unsigned int select_maxFD, select_pending;
 
 	static bool prtSigterm;
 	static bool prtHeapterm;
 
+	static Counters &counters();			// calling kernel thread's block
+	static Block *allocate();
+	static void release( Block *block );
+	static void snapshot( Counters &counts );	// sum of all blocks
+	static void delta( Counters &last, Counters &diff ); // diff = current - last, last = current
+	static void finishup();				// fold blocks at shutdown
 	static void print();
     }; // Statistics
 } // UPP
@@ -420,12 +457,16 @@ class uKernelModule {
     friend class uBaseTask;				// access: uKernelModuleBoot
     friend class UPP::uSerial;				// access: uKernelModuleBoot
     friend class uBaseSpinLock;				// access: uKernelModuleBoot
+    friend class uMCSLock;				// access: uKernelModuleBoot
     friend class uOwnerLock;				// access: uKernelModuleBoot, initialized
     template< int, int, int > friend class uAdaptiveLock; // access: uKernelModuleBoot, initialized
     friend class uCondLock;				// access: uKernelModuleBoot
     friend class uContext;				// access: uKernelModuleBoot
     friend _Coroutine UPP::uProcessorKernel;		// access: uKernelModuleBoot, globalProcessors, globalClusters, systemProcessor
     friend class uProcessor;				// access: everything
+#ifdef __U_STATISTICS__
+    friend struct UPP::Statistics;			// access: uKernelModuleBoot
+#endif // __U_STATISTICS__
     friend uBaseTask &uThisTask();			// access: uKernelModuleBoot
     friend uProcessor &uThisProcessor();		// access: uKernelModuleBoot
     friend uCluster &uThisCluster();			// access: uKernelModuleBoot
@@ -501,6 +542,12 @@ class uKernelModule {
 	bool RFpending;					// roll forward pending and needs execution
 
 	UPP::uProcessorKernel *processorKernelStorage;	// system-cluster processor kernel
+#if defined( __U_MULTI__ )
+	void *heapCache;				// kernel-thread free-block magazines (see uHeapLmmm.cc)
+#endif // __U_MULTI__
+#ifdef __U_STATISTICS__
+	UPP::Statistics::Counters *statistics;		// kernel-thread statistics block
+#endif // __U_STATISTICS__
 
 	// The thread pointer value needs to be accessible so that it can be properly restored on context switches.  On
 	// a non-tls system the thread pointer points directly at the kernel module, i.e. tp == This.  On a tls system
@@ -640,19 +687,33 @@ inline uBaseTask &uThisTask() {
 } // uThisTask
 
 
+#ifdef __U_STATISTICS__
+inline UPP::Statistics::Counters &UPP::Statistics::counters() {
+    // A task preempted and moved to another processor after this load still updates a valid block, and counting is
+    // atomic, so the only cost is a rare cross-processor write.
+    Counters *block = THREAD_GETMEM( statistics );
+    return block != NULL ? *block : bootBlock.counters; // NULL before the kernel module is initialized
+} // UPP::Statistics::counters
+#endif // __U_STATISTICS__
+
+
 //######################### uSpinLock #########################
 
 
 class uBaseSpinLock {					// non-yielding spinlock
     friend class UPP::uKernelBoot;			// access: new
     friend class uEventListPop;				// access: acquire_, release_
-    friend class uCluster;				// access: value
+    friend class uCluster;				// access: held
 
     unsigned int value;
 
     uBaseSpinLock( uBaseSpinLock & );			// no copy
     uBaseSpinLock &operator=( uBaseSpinLock & );	// no assignment
 
+    bool held() const {
+	return value != 0;
+    } // uBaseSpinLock::held
+
     void acquire_( bool rollforward );
 
     void release_( bool rollforward ) {
@@ -667,7 +728,7 @@ class uBaseSpinLock {					// non-yielding spinlock
   public:
     uBaseSpinLock() {
 #ifdef __U_STATISTICS__
-	uFetchAdd( UPP::Statistics::uSpinLocks, 1 );
+	uFetchAdd( UPP::Statistics::counters().uSpinLocks, 1 );
 #endif // __U_STATISTICS__
 	value = 0;					// unlock
     } // uBaseSpinLock::uBaseSpinLock
@@ -696,6 +757,68 @@ class uSpinLock : public uBaseSpinLock {		// handle alignment to prevent false s
 }; // __attribute__(( aligned (128) ));			// static allocation
 
 
+// Spin locks are bare words so the many locks embedded in monitors, semaphores and owner locks stay small.  Heavily
+// contended kernel locks instead use one of the following, which occupy a cache line alone (when their enclosing
+// object is cache-line aligned, e.g., the first field of a uCluster).
+
+class uAlignedSpinLock : public uBaseSpinLock {		// test-and-test-and-set spin lock on its own cache line
+    char padding[128 - sizeof(uBaseSpinLock)];		// pad to size of cacheline
+  public:
+    void *operator new( size_t size ) {			// dynamic allocation
+	return ::memalign( 128, size );
+    } // uAlignedSpinLock::operator new
+}; // uAlignedSpinLock
+
+
+class uMCSLock {					// queue spin lock, each waiter spins on its own node
+    friend class uCluster;				// access: held
+
+    // The queue is Mellor-Crummey/Scott with the K42 modification: the lock's own node represents the holder, so
+    // acquire and release need no node argument and a waiter's node only lives on its stack while it waits. The lock
+    // is handed over in FIFO order, which bounds waiting but stalls the queue if a waiting kernel thread is descheduled
+    // by the OS, so it is best when there are no more processors than CPUs.
+    struct Node {
+	Node *volatile tail;				// lock: last waiter or lock node when held, NULL when free; waiter: Waiting until granted
+	Node *volatile next;				// next waiter
+    }; // Node
+
+    Node lock;
+    char padding[128 - sizeof(Node)];			// pad to size of cacheline
+
+    uMCSLock( uMCSLock & );				// no copy
+    uMCSLock &operator=( uMCSLock & );			// no assignment
+
+    bool held() const {
+	return lock.tail != NULL;
+    } // uMCSLock::held
+  public:
+    uMCSLock() {
+#ifdef __U_STATISTICS__
+	uFetchAdd( UPP::Statistics::counters().uSpinLocks, 1 );
+#endif // __U_STATISTICS__
+	lock.tail = lock.next = NULL;			// unlock
+    } // uMCSLock::uMCSLock
+
+    void acquire();
+    bool tryacquire();
+    void release();
+
+    void *operator new( size_t size ) {			// dynamic allocation
+	return ::memalign( 128, size );
+    } // uMCSLock::operator new
+}; // uMCSLock
+
+
+// Lock type for the contended kernel locks (cluster ready queue and heap buckets). Define __U_QUEUE_LOCKS__ when
+// building the kernel to use queue locks for them.
+
+#if defined( __U_MULTI__ ) && defined( __U_QUEUE_LOCKS__ )
+typedef uMCSLock uKernelLock;
+#else
+typedef uAlignedSpinLock uKernelLock;
+#endif // __U_MULTI__ && __U_QUEUE_LOCKS__
+
+
 // RAII mutual-exclusion lock.  Useful for mutual exclusion in free routines.  Handles exception termination and
 // multiple block exit or return.
 
@@ -731,7 +854,7 @@ class uLock {						// yielding spinlock
 
     uLock( unsigned int val ) {
 #ifdef __U_STATISTICS__
-	uFetchAdd( UPP::Statistics::uLocks, 1 );
+	uFetchAdd( UPP::Statistics::counters().uLocks, 1 );
 #endif // __U_STATISTICS__
 #ifdef __U_DEBUG__
 	if ( val > 1 ) {
@@ -864,11 +987,12 @@ class uOwnerLock {
     uOwnerLock &operator=( uOwnerLock & );		// no assignment
 
     void add_( uBaseTask &task );			// helper routines for uCondLock
-    void release_();
+    void add_( uSequence<uBaseTaskDL> &tasks );
+    uBaseTask *release_();
   public:
     uOwnerLock() {
 #ifdef __U_STATISTICS__
-	uFetchAdd( UPP::Statistics::uOwnerLocks, 1 );
+	uFetchAdd( UPP::Statistics::counters().uOwnerLocks, 1 );
 #endif // __U_STATISTICS__
 	owner_ = NULL;					// no one owns the lock
 	count = 0;					// so count is zero
@@ -925,7 +1049,7 @@ class uCondLock {
   public:
     uCondLock() {
 #ifdef __U_STATISTICS__
-	uFetchAdd( UPP::Statistics::uCondLocks, 1 );
+	uFetchAdd( UPP::Statistics::counters().uCondLocks, 1 );
 #endif // __U_STATISTICS__
     } // uCondLock::uCondLock
 
@@ -981,7 +1105,7 @@ namespace UPP {
       public:
 	uSemaphore( int count = 1 ) : count( count ) {
 #ifdef __U_STATISTICS__
-	    uFetchAdd( UPP::Statistics::uSemaphores, 1 );
+	    uFetchAdd( UPP::Statistics::counters().uSemaphores, 1 );
 #endif // __U_STATISTICS__
 #ifdef __U_DEBUG__
 	    if ( count < 0 ) {
@@ -1095,6 +1219,51 @@ extern "C" void uSwitch( void *from, void *to ) asm ("uSwitch"); // assembler ro
 #endif
 
 
+// Cache of free coroutine/task stacks for a cluster. Stack storage is reserved with mmap and committed by the
+// operating system as the stack is touched. A freed stack, including its guard page, is kept for reuse by the next
+// coroutine or task created with the same stack size, up to a limit, and the pages of cached stacks are returned to the
+// operating system when a processor on the cluster becomes idle.
+
+namespace UPP {
+    class uStackCache {
+	struct Stack {					// stored at the end of a free stack's storage
+	    Stack *next;
+	    size_t length;				// mapped size of stack storage
+	    bool trimmed;				// pages already returned to operating system ?
+	};
+
+	uSpinLock lock;					// must be first field for alignment
+	Stack *stacks;					// LIFO list of free stacks, most recently used first
+	unsigned int count;				// number of cached stacks
+	unsigned int limit;				// maximum number of cached stacks
+	bool untrimmed;					// some cached stack has pages to return
+
+	static Stack *node( void *storage, size_t length ) {
+	    return (Stack *)((char *)storage + length - sizeof(Stack));
+	} // uStackCache::node
+
+	uStackCache( uStackCache & );			// no copy
+	uStackCache &operator=( uStackCache & );	// no assignment
+      public:
+	uStackCache() : stacks( NULL ), count( 0 ), limit( 0 ), untrimmed( false ) {}
+	~uStackCache();
+
+	static void *map( size_t length );
+	static void unmap( void *storage, size_t length );
+
+	void *get( size_t length );
+	void put( void *storage, size_t length );
+	void trim();
+
+	unsigned int setLimit( unsigned int limit );
+
+	unsigned int getLimit() const {
+	    return limit;
+	} // uStackCache::getLimit
+    }; // uStackCache
+} // UPP
+
+
 // Contains the machine dependent context and routines that initialize and switch between contexts.
 
 namespace UPP {
@@ -1109,6 +1278,7 @@ namespace UPP {
 	friend class ::uProcessor;			// access: storage
 	friend class uKernelBoot;			// access: storage
 	friend void *uKernelModule::startThread( void *p ); // acesss: invokeCoroutine
+	friend class uStackCache;			// access: pageSize
 
 	struct uContext_t {
 	    void *SP;
@@ -1137,7 +1307,9 @@ namespace UPP {
 	} extras;					// indicates extra work during the context switch
 	bool userStack;					// use specified stack storage ?
 
+	size_t storageLength() const;
 	void createContext( unsigned int stackSize );	// used by all constructors
+	void freeContext();
 
 	void startHere( void (*uInvoke)( uMachContext & ) );
 
@@ -1191,12 +1363,7 @@ namespace UPP {
 
 	virtual ~uMachContext() {
 	    if ( ! userStack ) {
-#ifdef __U_DEBUG__
-		if ( ::mprotect( storage, pageSize, PROT_READ | PROT_WRITE ) == -1 ) {
-		    uAbort( "(uMachContext &)%p.~uMachContext() : internal error, mprotect failure, error(%d) %s.", this, errno, strerror( errno ) );
-		} // if
-#endif // __U_DEBUG__
-		free( storage );
+		freeContext();
 	    } // if
 	} // uMachContext::~uMachContext
 
@@ -1343,7 +1510,7 @@ class uBaseCoroutine : public UPP::uMachContext {
 	state = s;
     } // uBaseCoroutine::setState
 
-    void contextSw();					// switch between a task and the kernel
+    void contextSw( uBaseTask *next = NULL );		// switch between a task and the kernel, or directly to next task
     void contextSw2();					// switch between two coroutine contexts
 
     void corStarter() {					// remembers who started a coroutine
@@ -1503,6 +1670,8 @@ class uBaseScheduleFriend {
     int setActiveQueue( uBaseTask &task1, int priority );
     int getBaseQueue( uBaseTask &task ) const;
     int setBaseQueue( uBaseTask &task, int priority );
+    static int getReadyIndex( uBaseTask &task );
+    static int setReadyIndex( uBaseTask &task, int index );
     bool isEntryBlocked( uBaseTask &task ) const;
     bool checkHookConditions( uBaseTask &task1, uBaseTask &task2 ) const;
 }; // uBaseScheduleFriend
@@ -1517,9 +1686,16 @@ template<typename Node> class uBaseSchedule : protected uBaseScheduleFriend {
     virtual void transfer( uBaseTaskSeq &from, unsigned int n = 0 ) = 0;
     virtual bool checkPriority( Node &owner, Node &calling ) = 0;
     virtual void resetPriority( Node &owner, Node &calling ) = 0;
-    virtual void addInitialize( uBaseTaskSeq &taskList ) = 0;
-    virtual void removeInitialize( uBaseTaskSeq &taskList ) = 0;
+    virtual void addInitialize( uBaseTaskDL *taskNode, uBaseTaskSeq &taskList ) = 0;
+    virtual void removeInitialize( uBaseTaskDL *taskNode, uBaseTaskSeq &taskList ) = 0;
     virtual void rescheduleTask( uBaseTaskDL *taskNode, uBaseTaskSeq &taskList ) = 0;
+
+    // Schedulers whose priorities depend on the set of tasks on the cluster return true, and are then told about each
+    // task added, removed or rescheduled with both the cluster's task list and ready queue locked. Otherwise, task
+    // creation and deletion never touch the ready-queue lock.
+    virtual bool initializeTasks() const {
+	return true;
+    } // uBaseSchedule::initializeTasks
 }; // uBaseSchedule
 
 
@@ -1543,7 +1719,7 @@ class uBasePrioritySeq : public uBaseScheduleFriend {
 
     virtual int add( uBaseTaskDL *node, uBaseTask *uOwner ) {
 #ifdef __U_STATISTICS__
-	uFetchAdd( UPP::Statistics::mutex_queue, 1 );
+	uFetchAdd( UPP::Statistics::counters().mutex_queue, 1 );
 #endif // __U_STATISTICS__
 	list.addTail( node );
 	return 0;
@@ -1551,14 +1727,14 @@ class uBasePrioritySeq : public uBaseScheduleFriend {
 
     virtual uBaseTaskDL *drop() {
 #ifdef __U_STATISTICS__
-	uFetchAdd( UPP::Statistics::mutex_queue, -1 );
+	uFetchAdd( UPP::Statistics::counters().mutex_queue, -1 );
 #endif // __U_STATISTICS__
 	return list.dropHead();
     } // uBasePrioritySeq::drop
 
     virtual void remove( uBaseTaskDL *node ) {
 #ifdef __U_STATISTICS__
-	uFetchAdd( UPP::Statistics::mutex_queue, -1 );
+	uFetchAdd( UPP::Statistics::counters().mutex_queue, -1 );
 #endif // __U_STATISTICS__
 	list.remove( node );
     } // uBasePrioritySeq::remove
@@ -1589,7 +1765,7 @@ class uBasePriorityQueue : public uBasePrioritySeq {
 
     virtual int add( uBaseTaskDL *node, uBaseTask *uOwner ) {
 #ifdef __U_STATISTICS__
-	uFetchAdd( UPP::Statistics::mutex_queue, 1 );
+	uFetchAdd( UPP::Statistics::counters().mutex_queue, 1 );
 #endif // __U_STATISTICS__
 	list.add( node );
 	return 0;					// dummy value
@@ -1597,7 +1773,7 @@ class uBasePriorityQueue : public uBasePrioritySeq {
 
     virtual uBaseTaskDL *drop() {
 #ifdef __U_STATISTICS__
-	uFetchAdd( UPP::Statistics::mutex_queue, -1 );
+	uFetchAdd( UPP::Statistics::counters().mutex_queue, -1 );
 #endif // __U_STATISTICS__
 	return list.drop();
     } // uBasePriorityQueue::drop
@@ -1605,7 +1781,7 @@ class uBasePriorityQueue : public uBasePrioritySeq {
     virtual void remove( uBaseTaskDL *node ) {
 	// Only used with default FIFO case, so node to remove is at the front of the list.
 #ifdef __U_STATISTICS__
-	uFetchAdd( UPP::Statistics::mutex_queue, -1 );
+	uFetchAdd( UPP::Statistics::counters().mutex_queue, -1 );
 #endif // __U_STATISTICS__
 	list.drop();
     } // uBasePriorityQueue::remove
@@ -1639,37 +1815,38 @@ class uDefaultScheduler : public uBaseSchedule<uBaseTaskDL> {
 #else
     void add( uBaseTaskDL *taskNode ) { list.addTail( taskNode );
 #ifdef __U_STATISTICS__
-	uFetchAdd( UPP::Statistics::ready_queue, 1 );
+	uFetchAdd( UPP::Statistics::counters().ready_queue, 1 );
 #endif // __U_STATISTICS__
     }
 #endif // KNOT
 
     uBaseTaskDL *drop() {
 #ifdef __U_STATISTICS__
-	uFetchAdd( UPP::Statistics::ready_queue, -1 );
+	uFetchAdd( UPP::Statistics::counters().ready_queue, -1 );
 #endif // __U_STATISTICS__
 	return list.dropHead();
     } // uDefaultScheduler::drop
 
     void remove( uBaseTaskDL *node ) {
 #ifdef __U_STATISTICS__
-	uFetchAdd( UPP::Statistics::ready_queue, -1 );
+	uFetchAdd( UPP::Statistics::counters().ready_queue, -1 );
 #endif // __U_STATISTICS__
 	list.remove( node );
     } // uDefaultScheduler::remove
 
     void transfer( uBaseTaskSeq &from, unsigned int n ) {
 #ifdef __U_STATISTICS__
-	uFetchAdd( UPP::Statistics::ready_queue, n );
+	uFetchAdd( UPP::Statistics::counters().ready_queue, n );
 #endif // __U_STATISTICS__
 	list.transfer( from );
     } // uDefaultScheduler::remove
 
     bool checkPriority( uBaseTaskDL &owner, uBaseTaskDL &calling ) { return false; }
     void resetPriority( uBaseTaskDL &owner, uBaseTaskDL &calling ) {}
-    void addInitialize( uBaseTaskSeq &taskList ) {};
-    void removeInitialize( uBaseTaskSeq &taskList ) {};
+    void addInitialize( uBaseTaskDL *taskNode, uBaseTaskSeq &taskList ) {};
+    void removeInitialize( uBaseTaskDL *taskNode, uBaseTaskSeq &taskList ) {};
     void rescheduleTask( uBaseTaskDL *taskNode, uBaseTaskSeq &taskList ) {};
+    bool initializeTasks() const { return false; };
 }; // uDefaultScheduler
 
 
@@ -2019,10 +2196,10 @@ class uBaseTask : public uBaseCoroutine {
     template< int, int, int > friend class uAdaptiveLock; // access: entryRef, profileActive, wake
     friend class uCondLock;				// access: entryRef, ownerLock, profileActive, wake
     friend class uBaseSpinLock;				// access: profileActive
-    friend class UPP::uSemaphore;			// access: entryRef, wake
-    friend class uRWLock;				// access: entryRef, wake, info
+    friend class UPP::uSemaphore;			// access: entryRef, readyRef, wake
+    friend class uRWLock;				// access: entryRef, readyRef, info, wake
     friend class uCondition;				// access: currCoroutine, mutexRef, info, profileActive
-    friend _Coroutine UPP::uProcessorKernel;		// access: currCoroutine, setState, wake
+    friend _Coroutine UPP::uProcessorKernel;		// access: currCoroutine, currCluster, bound, setState, wake
     friend _Task uProcessorTask;			// access: currCluster, uBaseTask
     friend class uCluster;				// access: currCluster, readyRef, clusterRef, bound
     friend _Task UPP::uBootTask;			// access: wake
@@ -2066,6 +2243,7 @@ class uBaseTask : public uBaseCoroutine {
     uBaseTask( uCluster &cluster, uProcessor &processor ); // only used by uProcessorTask
     void setState( State state );
     void wake();
+    static void wake( uBaseTaskSeq &readyTasks );
 
     uBaseTask( uBaseTask & );				// no copy
     uBaseTask &operator=( uBaseTask & );		// no assignment
@@ -2108,7 +2286,7 @@ class uBaseTask : public uBaseCoroutine {
     // real-time
 
     friend class UPP::uSerialMember;			// access: setSerial, currCoroutine, profileActive, acceptedCall
-    friend class uBaseScheduleFriend;			// access: entryRef, getInheritTask, setActivePriority, setBasePriority, setActiveQueue, setBaseQueue, uIsEntryBlocked
+    friend class uBaseScheduleFriend;			// access: entryRef, getInheritTask, setActivePriority, setBasePriority, setActiveQueue, setBaseQueue, readyIndex, uIsEntryBlocked
     friend class uWakeupHndlr;                          // access: wake
     friend class uBasePrioritySeq;			// access: entryRef, mutexRef, calledEntryMem
     friend class uRepositionEntry;			// access: entryList TEMPORARY
@@ -2122,6 +2300,7 @@ class uBaseTask : public uBaseCoroutine {
     uBaseTask *inheritTask;
     int queueIndex;
     int activeQueueIndex;
+    int readyIndex;					// position in a heap-ordered ready queue, 0 => not in heap
     UPP::uSerial *currSerial;				// current serial task is using (not original serial)
 
     unsigned int currSerialLevel;			// counter for checking non-nested entry/exit from multiple accessed mutex objects
@@ -2340,6 +2519,7 @@ class uCondition {
 
     void signal();					// signal condition
     void signalBlock();					// signal condition
+    void signalAll();					// signal all tasks on condition
 
     bool empty() const {				// test for tasks on a condition
 	return condQueue.empty();			// check if the condition queue is empty
@@ -2374,6 +2554,20 @@ class uCondition {
 
 
 namespace UPP {
+    // Operation performed asynchronously through io_uring; fields not used by an operation are ignored.
+
+    struct uIOUringOp {
+	enum Opcode { Read, Readv, Write, Writev, Recv, Send, Recvmsg, Sendmsg, Accept, Splice } opcode;
+	int fd;						// file descriptor operated on; splice: output fd
+	void *addr;					// buffer, iovec array, msghdr or accept address
+	void *addr2;					// accept: address length
+	unsigned int len;				// buffer length or iovec count
+	unsigned int flags;				// msg, accept or splice flags
+	long long int off;				// file offset, -1 => current position; splice: output offset
+	int fdIn;					// splice: input fd
+	long long int offIn;				// splice: input offset, -1 => current position
+    }; // uIOUringOp
+
 #ifdef KNOT
     _Mutex<uCeilingQ,uCeilingQ> class uNBIO {
 #else
@@ -2388,7 +2582,7 @@ namespace UPP {
 	    uSemaphore pending;				// wait for I/O completion
 	    uBaseTask *pendingTask;			// name of waiting task in case nominated to IOPoller
 	    int nfds;					// return value
-	    enum { singleFd, multipleFds } fdType;
+	    enum { singleFd, multipleFds, uringOp } fdType;
 	    bool timedout;				// has timeout
 	    bool *nbioTimeout;				// timeout in NBIO
 	    union {
@@ -2419,6 +2613,43 @@ namespace UPP {
 	uSequence<NBIOnode> pendingIOSfds[FD_SETSIZE];	// array of lists containing tasks waiting for an I/O event on a specific FD
 	uSequence<NBIOnode> pendingIOMfds;		// list of tasks waiting for an I/O event on a general FD mask or timeout
 
+#if defined( __U_EPOLL__ )
+	// When epollFD != -1, single fds are registered in an epoll set rather than the single masks, using one-shot
+	// triggering so each registration is woken once and then rearmed while tasks are still waiting.  Multiple-fd
+	// waits still use the masks, and the epoll set is polled by adding epollFD to the master read mask.
+
+	enum { EpollMaxEvents = 128 };			// ready fds returned per poll
+
+	struct EpollFd {
+	    uSequence<NBIOnode> pendingIO;		// tasks waiting for an I/O event on this FD without a timeout
+	    unsigned char armed;			// events (ReadSelect/WriteSelect/ExceptSelect) currently armed in epoll set
+	    unsigned char ready;			// events returned by the last poll
+	    unsigned char rearm;			// events of waiting tasks with timeout to rearm after the last poll
+	    bool registered;				// fd added to epoll set
+
+	    EpollFd() : armed( 0 ), ready( 0 ), rearm( 0 ), registered( false ) {}
+	}; // EpollFd
+
+	int epollFD;					// epoll set, -1 => select on single masks
+	EpollFd *epollFds;				// per fd state, indexed by fd, grows on demand
+	unsigned int epollFdsSize;			// number of elements in epollFds
+	int epollCnt;					// number of events in epollEvents
+	epoll_event epollEvents[EpollMaxEvents];	// events returned by the last poll
+#endif // __U_EPOLL__
+
+#if defined( __U_IOURING__ )
+	// When ring != NULL, operations are queued on the submission ring by the requesting task and submitted together
+	// by the poller before it polls, or immediately if the poller is blocked. The ring fd is in the epoll set so a
+	// completion wakes the poller, which reaps the completions and wakes the waiting tasks.
+
+	struct IOUring;					// rings mapped from kernel, defined in uNBIO.cc
+
+	IOUring *ring;					// io_uring instance, created on first use
+	int ringFD;					// io_uring fd, -1 => no io_uring
+	unsigned int ringUnsubmitted;			// operations queued but not yet submitted
+	uSequence<NBIOnode> pendingIOUring;		// list of tasks waiting for an io_uring completion
+#endif // __U_IOURING__
+
 	fd_set mRFDs, mWFDs, mEFDs;			// master copy of all single and multiple I/O
 	fd_set srfds, swfds, sefds;			// master copy of all single I/O
 	fd_set mrfds, mwfds, mefds;			// master copy of all multiple I/O
@@ -2442,6 +2673,20 @@ namespace UPP {
 	void performIO( int fd, NBIOnode *p, uSequence<NBIOnode> &pendingIO, int cnt );
 	void checkSfds( int fd, NBIOnode *p, uSequence<NBIOnode> &pendingIO );
 	void unblockFD( uSequence<NBIOnode> &pendingIO );
+	uSequence<NBIOnode> &pendingIOSfd( unsigned int fd );
+#if defined( __U_EPOLL__ )
+	int epollArm( int fd, unsigned int rwe );
+	void epollGrow( unsigned int fd );
+	void epollCheckSfds();
+#endif // __U_EPOLL__
+	void selectCheckSfds();
+#if defined( __U_IOURING__ )
+	_Mutex bool uringCreate();
+	void uringSubmit();
+	void uringReap();
+	_Mutex bool initUring( NBIOnode &node, uIOUringOp &op );
+	int uring( uIOUringOp &op );
+#endif // __U_IOURING__
 	_Mutex bool checkIOEnd( NBIOnode &node, int terrno );
 	bool checkPoller();
 	void waitOrPoll( NBIOnode &node, uEventNode *timeoutEvent = NULL );
@@ -2453,6 +2698,7 @@ namespace UPP {
 	int select( int nfds, fd_set *rfds, fd_set *wfds, fd_set *efds, timeval *timeout = NULL );
 
 	uNBIO();
+	~uNBIO();
       public:
     }; // uNBIO
 } // UPP
@@ -2477,17 +2723,23 @@ namespace UPP {
 	friend _Task ::uProcessorTask;			// access: terminated, kernelClock
 	friend class ::uProcessor;			// access: uProcessorKernel
 	friend class uNBIO;				// access: kernelClock
+	friend class uMachContext;			// access: switchComplete
 
 	// real-time
 
-	friend class ::uEventList;			// access: schedule
+	friend class ::uEventList;			// access: schedule, kernelClock
 	friend class ::uEventListPop;			// access: kernelClock
 
 	unsigned int kind;				// specific kind of schedule operation
 	uBaseSpinLock *prevLock;			// comunication
 	uBaseTask *nextTask;				// task to be wakened
+#ifdef __U_MULTI__
+	bool direct;					// previous task switched directly to the current task
+#endif // __U_MULTI__
 
 	void taskIsBlocking();
+	void switchTask();
+	static void switchComplete();
 	static void schedule();
 	static void schedule( uBaseSpinLock *lock );
 	static void schedule( uBaseTask *task );
@@ -2539,14 +2791,17 @@ inline void uBaseTask::uYieldNoPoll() {
 class uProcessor {
     friend class UPP::uKernelBoot;			// access: new, uProcessor, events, contextEvent, contextSwitchHandler, setContextSwitchEvent
     friend class uKernelModule;				// access: events
-    friend class uCluster;				// access: pid, idleRef, external, processorRef, setContextSwitchEvent
-    friend _Coroutine UPP::uProcessorKernel;		// access: events, currCluster, procTask, external, globalRef, setContextSwitchEvent
+    friend class uCluster;				// access: pid, idleRef, external, processorRef, setContextSwitchEvent, terminated, localReadyLock, localReadyQueue, park, unpark
+    friend _Coroutine UPP::uProcessorKernel;		// access: events, currCluster, procTask, external, terminated, globalRef, setContextSwitchEvent
     friend _Task uProcessorTask;			// access: pid, processorClock, preemption, currCluster, setContextSwitchEvent
-    friend class UPP::uNBIO;				// access: setContextSwitchEvent
+    friend class UPP::uNBIO;				// access: setContextSwitchEvent, parkState
     friend class uEventList;				// access: events, contextSwitchHandler
     friend class uEventNode;                            // access: events
     friend class uEventListPop;                         // access: contextSwitchHandler
     friend void *uKernelModule::startThread( void *p ); // acesss: everything
+#if defined( __U_PROCESSOR_FUTEX__ )
+    friend class UPP::uSigHandlerModule;		// access: parkState
+#endif // __U_PROCESSOR_FUTEX__
     friend class UPP::uMachContext;			// access: procTask
 #if defined( __i386__ ) || defined( __ia64__ ) && ! defined( __old_perfmon__ )
     friend class HWCounters;				// access: uPerfctrContext (i386) or uPerfmon_fd (ia64)
@@ -2565,7 +2820,13 @@ class uProcessor {
     friend class uProfileProcessorSampler;		// access: profileProcessorSamplerInstance
 #endif // __U_PROFILER__
 
-    static uEventList *events;				// single list of events for all processors
+#if ! defined( __U_PROCESSOR_TIMER__ )
+    static						// single list of events for all processors
+#endif // ! __U_PROCESSOR_TIMER__
+    uEventList *events;					// events set by tasks executing on this processor
+#if defined( __U_PROCESSOR_TIMER__ )
+    static uEventList *retiredEvents;			// event lists of deleted processors for reuse
+#endif // __U_PROCESSOR_TIMER__
 #if ! defined( __U_MULTI__ )
     static						// shared info on uniprocessor
 #endif // ! __U_MULTI__
@@ -2575,6 +2836,10 @@ class uProcessor {
 #endif // ! __U_MULTI__
     uCxtSwtchHndlr *contextSwitchHandler;		// special time slice handler
 
+#if defined( __U_STATISTICS__ ) && defined( __U_MULTI__ )
+    UPP::Statistics::Block *statistics;			// counters of this processor's kernel thread
+#endif // __U_STATISTICS__ && __U_MULTI__
+
 #ifdef __U_MULTI__
     UPP::uProcessorKernel processorKer;			// need a uProcessorKernel
 #endif // __U_MULTI__
@@ -2608,6 +2873,9 @@ class uProcessor {
     uProcessorTask *procTask;				// handle processor specific requests
     uBaseTaskSeq external;				// ready queue for processor task
 
+    uSpinLock localReadyLock;				// protect localReadyQueue
+    uDefaultScheduler localReadyQueue;			// tasks made ready by this processor on a work-stealing cluster
+
     uCluster *currCluster;				// cluster processor currently associated with
 
     bool detached;					// processor detached ?
@@ -2619,6 +2887,17 @@ class uProcessor {
 // TEMPORARY
     unsigned long long int startTime;
 
+#if defined( __U_PROCESSOR_FUTEX__ )
+    // An idle processor parks on parkState (futex word) rather than waiting for SIGUSR1. A processor blocked in the I/O
+    // poller is Polling and still needs SIGUSR1 to interrupt its select.
+    enum { Active, Parked, Polling };
+    enum { ParkSpin = 128 };				// checks of parkState before blocking in kernel
+    volatile int parkState;
+
+    bool park();
+    bool unpark();
+#endif // __U_PROCESSOR_FUTEX__
+
     void createProcessor( uCluster &cluster, bool detached, int ms, int spin );
     void fork( uProcessor *processor );
     void setContextSwitchEvent( int msecs );		// set the real-time timer
@@ -2719,18 +2998,19 @@ class uCluster {
     friend class uEventListPop;				// access: processorsOnCluster
     friend class UPP::uNBIO::uSelectTimeoutHndlr;	// access: NBIO, wakeProcessor
     friend class UPP::uKernelBoot;			// access: new, NBIO, taskAdd, taskRemove
-    friend _Coroutine UPP::uProcessorKernel;		// access: NBIO, readyQueueTryRemove, readyQueueEmpty, tasksOnCluster, makeProcessorActive, processorPause
+    friend _Coroutine UPP::uProcessorKernel;		// access: NBIO, readyQueueTryRemove, readyQueueEmpty, handoff, tasksOnCluster, makeProcessorActive, processorPause
     friend _Task uProcessorTask;			// access: processorAdd, processorRemove
     friend class uProcessor;				// access: processorAdd, processorRemove
     friend class uRealTimeBaseTask;			// access: taskReschedule
     friend class uPeriodicBaseTask;			// access: taskReschedule
     friend class uSporadicBaseTask;			// access: taskReschedule
     friend class uIOClosure;				// access: select
-    friend class uRWLock;				// access: makeTaskReady
+    friend class UPP::uMachContext;			// access: stackCache
 
     // must be first field for alignment
-    uSpinLock readyIdleTaskLock;			// protect readyQueue, idleProcessors and tasksOnCluster
+    uKernelLock readyIdleTaskLock;			// protect readyQueue and idleProcessors
     uSpinLock processorsOnClusterLock;
+    uSpinLock tasksOnClusterLock;			// protect tasksOnCluster, acquired before readyIdleTaskLock
 
     // debugging
 
@@ -2762,12 +3042,16 @@ class uCluster {
     const char *name;					// textual name for cluster, default value
     uBaseSchedule<uBaseTaskDL> *readyQueue;		// list of tasks awaiting execution by processors on this cluster
     bool defaultReadyQueue;				// indicates if the cluster allocated the ready queue
+    bool workStealing;					// tasks are queued on per-processor ready queues and stolen when idle
+    bool uringIO;					// file and socket I/O is performed through io_uring
+    bool handoff;					// blocking task restarts the task it wakes ahead of other ready tasks
     unsigned int idleProcessorsCnt;			// number of idle processors
     uProcessorSeq idleProcessors;			// list of idle processors associated with this cluster
     uBaseTaskSeq tasksOnCluster;			// list of tasks on this cluster
     uProcessorSeq processorsOnCluster;			// list of processors associated with this cluster
     unsigned int numProcessors;				// number of processors on cluster
     unsigned int stackSize;				// default stack size for tasks created on cluster
+    UPP::uStackCache stackCache;			// free stacks for coroutines and tasks created on cluster
 
     uClusterDL wakeupList;				// double link field: list of clusters with wakeups
 
@@ -2782,19 +3066,25 @@ class uCluster {
     mutable uProfileClusterSampler *profileClusterSamplerInstance; // pointer to related profiling object
 
     static void wakeProcessor( uPid_t pid );
+    static void wakeProcessor( uProcessor &processor );
     void processorPause();
     void makeProcessorIdle( uProcessor &processor );
     void makeProcessorActive( uProcessor &processor );
     void makeProcessorActive();
 
+    bool localReadyQueuesEmpty();
+
     bool readyQueueEmpty() {
-	return readyQueue->empty();
+	return readyQueue->empty() && ( ! workStealing || localReadyQueuesEmpty() );
     } // uCluster::readyQueueEmpty
 
+    void wakeIdleProcessors( unsigned int n );
     void makeTaskReady( uBaseTask &readyTask );
     void makeTaskReady( uSequence<uBaseTaskDL> &readyQueue, unsigned int n );
     void readyQueueRemove( uBaseTaskDL *task );
     uBaseTask &readyQueueTryRemove();
+    uBaseTask *readyQueueSteal( uProcessor &thief );
+    void readyQueueDrain( uProcessor &processor );
     void taskAdd( uBaseTask &task );
     void taskRemove( uBaseTask &task );
     void taskReschedule( uBaseTask &task );
@@ -2808,11 +3098,17 @@ class uCluster {
     int select( uIOClosure &closure, int rwe, timeval *timeout = NULL ) {
 	return NBIO->select( closure, rwe, timeout );
     } // uCluster::select
+
+    int uring( UPP::uIOUringOp &op );
   public:
+    enum ReadyQueueMode { SharedReadyQueue, WorkStealingReadyQueue };
+
     uCluster( unsigned int stackSize = uDefaultStackSize(), const char *name = "*unnamed*" );
     uCluster( const char *name );
     uCluster( uBaseSchedule<uBaseTaskDL> &ReadyQueue, unsigned int stackSize = uDefaultStackSize(), const char *name = "*unnamed*" );
     uCluster( uBaseSchedule<uBaseTaskDL> &ReadyQueue, const char *name = "*unnamed*" );
+    uCluster( ReadyQueueMode mode, unsigned int stackSize = uDefaultStackSize(), const char *name = "*unnamed*" );
+    uCluster( ReadyQueueMode mode, const char *name );
     virtual ~uCluster();
 
     const char *setName( const char *name ) {
@@ -2839,6 +3135,28 @@ class uCluster {
 	return stackSize;
     } // uCluster::getStackSize
 
+    unsigned int setStackCache( unsigned int stacks ) {
+	return stackCache.setLimit( stacks );
+    } // uCluster::setStackCache
+
+    unsigned int getStackCache() const {
+	return stackCache.getLimit();
+    } // uCluster::getStackCache
+
+    ReadyQueueMode getReadyQueueMode() const {
+	return workStealing ? WorkStealingReadyQueue : SharedReadyQueue;
+    } // uCluster::getReadyQueueMode
+
+    bool setHandoff( bool enable ) {
+	bool prev = handoff;
+	handoff = enable;
+	return prev;
+    } // uCluster::setHandoff
+
+    bool getHandoff() const {
+	return handoff;
+    } // uCluster::getHandoff
+
     void taskResetPriority( uBaseTask &owner, uBaseTask &calling );
     void taskSetPriority( uBaseTask &owner, uBaseTask &calling );
 
@@ -2850,6 +3168,12 @@ class uCluster {
 	return NBIO->select( nfds, rfd, wfd, efd, timeout );
     } // uCluster::select
 
+    bool setIOUring( bool enable );
+
+    bool getIOUring() const {
+	return uringIO;
+    } // uCluster::getIOUring
+
     const uBaseTaskSeq &getTasksOnCluster() {
 	return tasksOnCluster;
     } // uCluster::getTasksOnCluster
@@ -3057,10 +3381,12 @@ namespace UPP {
 	friend class UPP::uMachContext;			// access: startTask, finishup
 	friend class ::uBaseTask;			// access: prepareTask
 	friend class UPP::PthreadLock;			// access: startup
+	friend _Coroutine UPP::uProcessorKernel;	// access: finishThread
 
 	static bool traceHeap_;				// trace allocations and deallocations
 
 	static void finishup();
+	static void finishThread();
 	static void prepareTask( uBaseTask *task );
 	static void startTask();
 	static void finishTask();
@@ -30,6 +30,7 @@
 
 #include <uC++.h>
 #include <uIOcntl.h>
+#include <uProcessor.h>
 #ifdef __U_PROFILER__
 #include <uProfiler.h>
 #endif // __U_PROFILER__
@@ -47,7 +48,7 @@ void uCluster::wakeProcessor( uPid_t pid ) {
     uDebugPrt( "uCluster::wakeProcessor: waking processor %lu\n", (unsigned long)pid );
 #endif // __U_DEBUG_H__
 #ifdef __U_STATISTICS__
-    uFetchAdd( UPP::Statistics::wake_processor, 1 );
+    uFetchAdd( UPP::Statistics::counters().wake_processor, 1 );
 #endif // __U_STATISTICS__
 
 #if defined( __U_MULTI__ )
@@ -75,6 +76,25 @@ void uCluster::wakeProcessor( uPid_t pid ) {
 } // uCluster::wakeProcessor
 
 
+void uCluster::wakeProcessor( uProcessor &processor ) {
+#if defined( __U_PROCESSOR_FUTEX__ )
+    if ( processor.unpark() ) {				// parked ?
+#ifdef __U_DEBUG_H__
+	uDebugPrt( "uCluster::wakeProcessor: unparked processor %p\n", &processor );
+#endif // __U_DEBUG_H__
+#ifdef __U_STATISTICS__
+	uFetchAdd( UPP::Statistics::counters().wake_processor, 1 );
+#endif // __U_STATISTICS__
+    } else if ( processor.parkState == uProcessor::Polling ) { // blocked in I/O poller ?
+	wakeProcessor( processor.pid );
+    } // if
+    // otherwise, processor is already awake and rechecks the ready queue before pausing again
+#else
+    wakeProcessor( processor.pid );
+#endif // __U_PROCESSOR_FUTEX__
+} // uCluster::wakeProcessor
+
+
 void uCluster::processorPause() {
     assert( THREAD_GETMEM( disableInt ) && THREAD_GETMEM( disableIntCnt ) > 0 );
 
@@ -92,6 +112,60 @@ void uCluster::processorPause() {
 	uDebugPrt( "(uCluster &)%p.processorPause, found work\n", this );
 #endif // __U_DEBUG_H__
     } else {
+#if defined( __U_PROCESSOR_FUTEX__ )
+	// Park on the processor's futex word instead of sigsuspend. Signals stay unblocked; parkState is set before the
+	// roll-forward check so a signal arriving after the check resets it and the park does not block.
+	uProcessor &processor = uThisProcessor();
+	processor.parkState = uProcessor::Parked;
+
+	if ( ! THREAD_GETMEM( RFinprogress ) && THREAD_GETMEM( RFpending ) ) { // need to start roll forward ?
+	    processor.parkState = uProcessor::Active;
+	    readyIdleTaskLock.release();
+#ifdef __U_DEBUG_H__
+	    uDebugPrt( "(uCluster &)%p.processorPause, found roll forward %d %d %d\n", this, THREAD_GETMEM( RFinprogress ), THREAD_GETMEM( RFpending ), THREAD_GETMEM( disableIntSpin ) );
+#endif // __U_DEBUG_H__
+	} else {
+	    makeProcessorIdle( processor );
+	    readyIdleTaskLock.release();
+
+#ifdef __U_DEBUG_H__
+	    uDebugPrt( "(uCluster &)%p.processorPause, before park\n", this );
+#endif // __U_DEBUG_H__
+
+#ifdef __U_STATISTICS__
+	    uFetchAdd( UPP::Statistics::counters().kernel_thread_pause, 1 );
+#endif // __U_STATISTICS__
+
+	    stackCache.trim();				// return pages of unused stacks while idle
+
+#ifdef __U_STATISTICS__
+	    if ( processor.park() ) {
+		uFetchAdd( UPP::Statistics::counters().wakeup_spin, 1 );
+	    } // if
+#else
+	    processor.park();
+#endif // __U_STATISTICS__
+
+#if defined( __i386__ ) || defined( __x86_64__ )
+	    processor.startTime = uRead_tsc();
+#endif
+
+#ifdef __U_DEBUG_H__
+	    uDebugPrt( "(uCluster &)%p.processorPause, after park\n", this );
+#endif // __U_DEBUG_H__
+
+	    makeProcessorActive( processor );
+
+#ifdef __U_STATISTICS__
+	    // A wakeup is productive if there is something to do, otherwise the processor spins and pauses again.
+	    if ( ! readyQueueEmpty() || ! processor.external.empty() || THREAD_GETMEM( RFpending ) ) {
+		uFetchAdd( UPP::Statistics::counters().wakeup_productive, 1 );
+	    } else {
+		uFetchAdd( UPP::Statistics::counters().wakeup_spurious, 1 );
+	    } // if
+#endif // __U_STATISTICS__
+	} // if
+#else
 	// Block any SIGALRM/SIGUSR1 signals from arriving.
 	sigset_t new_mask, old_mask;
 	sigemptyset( &new_mask );
@@ -120,9 +194,11 @@ void uCluster::processorPause() {
 #endif // __U_DEBUG_H__
 
 #ifdef __U_STATISTICS__
-	    uFetchAdd( UPP::Statistics::kernel_thread_pause, 1 );
+	    uFetchAdd( UPP::Statistics::counters().kernel_thread_pause, 1 );
 #endif // __U_STATISTICS__
 
+	    stackCache.trim();				// return pages of unused stacks while idle
+
 	    sigsuspend( &old_mask );			// install old signal mask over new one and wait for signal to arrive
 
 	    if ( sigprocmask( SIG_SETMASK, &old_mask, NULL ) == -1 ) { // new mask restored so install old signal mask over new one
@@ -138,7 +214,16 @@ void uCluster::processorPause() {
 #endif // __U_DEBUG_H__
 
 	    makeProcessorActive( uThisProcessor() );
+
+#ifdef __U_STATISTICS__
+	    if ( ! readyQueueEmpty() || ! uThisProcessor().external.empty() || THREAD_GETMEM( RFpending ) ) {
+		uFetchAdd( UPP::Statistics::counters().wakeup_productive, 1 );
+	    } else {
+		uFetchAdd( UPP::Statistics::counters().wakeup_spurious, 1 );
+	    } // if
+#endif // __U_STATISTICS__
 	} // if
+#endif // __U_PROCESSOR_FUTEX__
     } // if
 
     if ( uThisProcessor().getPreemption() != 0 ) {	// optimize out UNIX call if possible
@@ -157,7 +242,7 @@ void uCluster::processorPause() {
 
 
 void uCluster::makeProcessorIdle( uProcessor &processor ) {
-    assert( readyIdleTaskLock.value != 0 );		// readyIdleTaskLock must be acquired
+    assert( readyIdleTaskLock.held() );		// readyIdleTaskLock must be acquired
     idleProcessorsCnt += 1;
     idleProcessors.addTail( &(processor.idleRef) );
 } // uCluster::makeProcessorIdle
@@ -183,18 +268,68 @@ void uCluster::makeProcessorActive() {
     uDebugPrt( "(uCluster &)%p.makeProcessorActive(2)\n", this );
 #endif // __U_DEBUG_H__
     readyIdleTaskLock.acquire();
-    if ( ! readyQueue->empty() && ! idleProcessors.empty() ) {
-	uPid_t pid = idleProcessors.dropHead()->processor().pid;
+    if ( ! readyQueueEmpty() && ! idleProcessors.empty() ) {
+	uProcessor &processor = idleProcessors.dropHead()->processor();
 	idleProcessorsCnt -= 1;
-	readyIdleTaskLock.release();			// don't hold lock while sending SIGALRM
-	wakeProcessor( pid );
+	readyIdleTaskLock.release();			// don't hold lock while waking processor
+	wakeProcessor( processor );
     } else {
 	readyIdleTaskLock.release();
     } // if
 } // uCluster::makeProcessorActive
 
 
+void uCluster::wakeIdleProcessors( unsigned int n ) {
+    // Wake up to n idle processors so they can steal work from the local ready queues.
+
+    readyIdleTaskLock.acquire();
+    if ( ! idleProcessors.empty() ) {
+	uProcessorSeq restart;
+	for ( unsigned int i = 0; i < n && ! idleProcessors.empty(); i += 1 ) {
+	    restart.addTail( idleProcessors.dropHead() );
+	    idleProcessorsCnt -= 1;
+	} // for
+	readyIdleTaskLock.release();			// don't hold lock while waking processors
+	for ( ; ! restart.empty(); ) {
+	    wakeProcessor( restart.dropHead()->processor() );
+	} // for
+    } else {
+	readyIdleTaskLock.release();
+    } // if
+} // uCluster::wakeIdleProcessors
+
+
 void uCluster::makeTaskReady( uBaseTask &readyTask ) {
+#ifdef __U_MULTI__
+    if ( workStealing && &readyTask.bound == NULL ) {
+	// Put the task on the local ready queue of the processor making it ready, which avoids the cluster-wide
+	// readyIdleTaskLock. The processor must be on this cluster and not shutting down, otherwise the task could be
+	// stranded on a queue no processor of this cluster services, so those tasks fall through to the shared queue.
+
+	uProcessor &processor = uThisProcessor();
+	processor.localReadyLock.acquire();
+	if ( processor.currCluster == this && ! processor.terminated ) {
+	    bool busy = ! processor.localReadyQueue.empty();
+	    processor.localReadyQueue.add( &(readyTask.readyRef) ); // add task to end of processor ready queue
+	    processor.localReadyLock.release();
+#ifdef __U_DEBUG_H__
+	    uDebugPrt( "(uCluster &)%p.makeTaskReady(3): task %.256s (%p) makes task %.256s (%p) ready on processor %p\n",
+		       this, uThisTask().getName(), &uThisTask(), readyTask.getName(), &readyTask, &processor );
+#endif // __U_DEBUG_H__
+	    // Only wake an idle processor if there is more work than this processor can do next. A task yielding
+	    // through the processor kernel onto an empty local queue runs again immediately, so waking a processor to
+	    // steal it just migrates the task. The idle count is read without the lock; at worst a processor is not
+	    // woken and the task waits for this processor, which is running.
+
+	    if ( idleProcessorsCnt != 0 && ( busy || &uThisTask() != processor.procTask ) ) {
+		wakeIdleProcessors( 1 );
+	    } // if
+	    return;
+	} // if
+	processor.localReadyLock.release();
+    } // if
+#endif // __U_MULTI__
+
     readyIdleTaskLock.acquire();
     if ( &readyTask.bound != NULL ) {			// task bound to a specific processor ?
 #ifdef __U_DEBUG_H__
@@ -207,9 +342,8 @@ void uCluster::makeTaskReady( uBaseTask &readyTask ) {
 	if ( p->idle() ) {				// processor on idle queue ?
 	    idleProcessors.remove( &(p->idleRef) );
 	    idleProcessorsCnt -= 1;
-	    uPid_t pid = p->pid;
-	    readyIdleTaskLock.release();		// don't hold lock while sending SIGALRM
-	    wakeProcessor( pid );
+	    readyIdleTaskLock.release();		// don't hold lock while waking processor
+	    wakeProcessor( *p );
 	} else {
 	    readyIdleTaskLock.release();
 	} // if
@@ -234,10 +368,10 @@ void uCluster::makeTaskReady( uBaseTask &readyTask ) {
 //	if ( ! idleProcessors.empty() && ( &uThisCluster() != this || duration > 300000 ) ) {
 //	    uThisProcessor().startTime = uRead_tsc();
 #endif
-	    uPid_t pid = idleProcessors.dropHead()->processor().pid;
+	    uProcessor &processor = idleProcessors.dropHead()->processor();
 	    idleProcessorsCnt -= 1;
-	    readyIdleTaskLock.release();		// don't hold lock while sending SIGALRM
-	    wakeProcessor( pid );
+	    readyIdleTaskLock.release();		// don't hold lock while waking processor
+	    wakeProcessor( processor );
 	} else {
 	    readyIdleTaskLock.release();
 	} // if
@@ -249,8 +383,24 @@ void uCluster::makeTaskReady( uBaseTask &readyTask ) {
 
 
 void uCluster::makeTaskReady( uBaseTaskSeq &newTasks, unsigned int n ) {
+#ifdef __U_MULTI__
+    if ( workStealing ) {
+	uProcessor &processor = uThisProcessor();
+	processor.localReadyLock.acquire();
+	if ( processor.currCluster == this && ! processor.terminated ) { // see single task version
+	    processor.localReadyQueue.transfer( newTasks, n ); // add task(s) to end of processor ready queue
+	    processor.localReadyLock.release();
+	    if ( idleProcessorsCnt != 0 ) {
+		wakeIdleProcessors( n );
+	    } // if
+	    return;
+	} // if
+	processor.localReadyLock.release();
+    } // if
+#endif // __U_MULTI__
+
     readyIdleTaskLock.acquire();
-    // cannot be bound task as all tasks come from RW lock
+    // cannot be bound task as uBaseTask::wake wakes those individually
 #ifdef __U_DEBUG_H__
     uDebugPrt( "(uCluster &)%p.makeTaskReady(2): task %.256s (%p) tasks ready\n",
 	       this, uThisTask().getName(), &uThisTask() );
@@ -259,10 +409,8 @@ void uCluster::makeTaskReady( uBaseTaskSeq &newTasks, unsigned int n ) {
     readyQueue->transfer( newTasks, n );		// add task(s) to end of cluster ready queue
 
 #ifdef __U_MULTI__
-    // Wake up an idle processor if the ready task is migrating to another cluster with idle processors or if the
-    // ready task is on the same cluster but the ready queue of that cluster is not empty. This check prevents a
-    // single task on a cluster, which does a yield, from unnecessarily waking up a processor that has no work to
-    // do.
+    // Wake up one idle processor per ready task, as far as there are idle processors, so a broadcast does not leave
+    // the released tasks queued behind a single processor.
 
     if ( ! idleProcessors.empty() && ( &uThisCluster() != this || ! readyQueue->empty() ) ) {
 	uProcessorSeq restart;
@@ -270,10 +418,9 @@ void uCluster::makeTaskReady( uBaseTaskSeq &newTasks, unsigned int n ) {
 	    restart.addTail( idleProcessors.dropHead() );
 	    idleProcessorsCnt -= 1;
 	} // for
-	readyIdleTaskLock.release();			// don't hold lock while sending SIGALRM
+	readyIdleTaskLock.release();			// don't hold lock while waking processors
 	for ( ; ! restart.empty(); ) {
-	    uPid_t pid = restart.dropHead()->processor().pid;
-	    wakeProcessor( pid );
+	    wakeProcessor( restart.dropHead()->processor() );
 	} // for
     } else {
 	readyIdleTaskLock.release();
@@ -291,11 +438,107 @@ void uCluster::readyQueueRemove( uBaseTaskDL *node ) {
 } // uCluster::readyQueueRemove
 
 
+bool uCluster::localReadyQueuesEmpty() {
+    bool empty = true;
+    uProcessorDL *pr;
+
+    processorsOnClusterLock.acquire();
+    for ( uSeqIter<uProcessorDL> iter( processorsOnCluster ); iter >> pr; ) {
+	if ( ! pr->processor().localReadyQueue.empty() ) {
+	    empty = false;
+	    break;
+	} // if
+    } // for
+    processorsOnClusterLock.release();
+    return empty;
+} // uCluster::localReadyQueuesEmpty
+
+
+uBaseTask *uCluster::readyQueueSteal( uProcessor &thief ) {
+    // Take a task from the local ready queue of a sibling processor. The scan starts after the thief so idle
+    // processors spread out over the victims, and busy locks are skipped rather than waited for because the idle loop
+    // retries shortly.
+
+    uBaseTask *task = NULL;
+
+  if ( ! processorsOnClusterLock.tryacquire() ) return NULL;
+    assert( thief.processorRef.listed() );
+    for ( uProcessorDL *victim = processorsOnCluster.succ( &thief.processorRef );; victim = processorsOnCluster.succ( victim ) ) {
+	if ( victim == NULL ) victim = processorsOnCluster.head(); // make list appear circular
+      if ( victim == &thief.processorRef ) break;	// all siblings checked ?
+	uProcessor &processor = victim->processor();
+	if ( ! processor.localReadyQueue.empty() && processor.localReadyLock.tryacquire() ) {
+	    if ( ! processor.localReadyQueue.empty() ) { // double check
+		task = &(processor.localReadyQueue.drop()->task());
+	    } // if
+	    processor.localReadyLock.release();
+	  if ( task != NULL ) break;
+	} // if
+    } // for
+    processorsOnClusterLock.release();
+
+#ifdef __U_STATISTICS__
+    if ( task != NULL ) uFetchAdd( UPP::Statistics::counters().work_steals, 1 );
+#endif // __U_STATISTICS__
+    return task;
+} // uCluster::readyQueueSteal
+
+
+void uCluster::readyQueueDrain( uProcessor &processor ) {
+    // Move the tasks on a processor's local ready queue to the shared ready queue when the processor leaves the cluster,
+    // and wake an idle processor to run them.
+
+    uBaseTaskSeq tasks;
+    unsigned int n = 0;
+
+    processor.localReadyLock.acquire();
+    for ( ; ! processor.localReadyQueue.empty(); n += 1 ) {
+	tasks.addTail( processor.localReadyQueue.drop() );
+    } // for
+    processor.localReadyLock.release();
+  if ( n == 0 ) return;
+
+    readyIdleTaskLock.acquire();
+    readyQueue->transfer( tasks, n );			// add task(s) to end of cluster ready queue
+    readyIdleTaskLock.release();
+    makeProcessorActive();
+} // uCluster::readyQueueDrain
+
+
 uBaseTask &uCluster::readyQueueTryRemove() {
     // Select a task from the ready queue of this cluster if there are no ready tasks, return the nil pointer.
 
     uBaseTask *task;
 
+#ifdef __U_MULTI__
+    if ( workStealing ) {
+	// The shared queue holds tasks migrating onto the cluster and tasks from departed processors; check it first so
+	// a busy local queue cannot starve them. The emptiness checks are done without locks to keep the uncontended
+	// path off the cluster lock.
+
+	uProcessor &processor = uThisProcessor();
+	task = NULL;
+	if ( ! readyQueue->empty() ) {
+	    readyIdleTaskLock.acquire();
+	    if ( ! readyQueue->empty() ) {		// double check
+		task = &(readyQueue->drop()->task());
+	    } // if
+	    readyIdleTaskLock.release();
+	} // if
+	if ( task == NULL && ! processor.localReadyQueue.empty() ) {
+	    processor.localReadyLock.acquire();
+	    if ( ! processor.localReadyQueue.empty() ) { // double check, queue may have been stolen from
+		task = &(processor.localReadyQueue.drop()->task());
+	    } // if
+	    processor.localReadyLock.release();
+	} // if
+	if ( task == NULL ) {
+	    task = readyQueueSteal( processor );
+	} // if
+	return *task;
+    } // if
+#endif // __U_MULTI__
+
     readyIdleTaskLock.acquire();
     if ( ! readyQueueEmpty() ) {
 	task = &(readyQueue->drop()->task());
@@ -308,25 +551,36 @@ uBaseTask &uCluster::readyQueueTryRemove() {
 
 
 void uCluster::taskAdd( uBaseTask &task ) {
-    readyIdleTaskLock.acquire();
+    tasksOnClusterLock.acquire();
     tasksOnCluster.addTail( &(task.clusterRef) );
-    if ( &task.bound == NULL ) readyQueue->addInitialize( tasksOnCluster ); // processor task is not part of normal initialization
-    readyIdleTaskLock.release();
+    if ( &task.bound == NULL && readyQueue->initializeTasks() ) { // processor task is not part of normal initialization
+	readyIdleTaskLock.acquire();			// scheduler may change priorities of ready tasks
+	readyQueue->addInitialize( &(task.clusterRef), tasksOnCluster );
+	readyIdleTaskLock.release();
+    } // if
+    tasksOnClusterLock.release();
 } // uCluster::taskAdd
 
 
 void uCluster::taskRemove( uBaseTask &task ) {
-    readyIdleTaskLock.acquire();
+    tasksOnClusterLock.acquire();
     tasksOnCluster.remove( &(task.clusterRef) );
-    if ( &task.bound == NULL ) readyQueue->removeInitialize( tasksOnCluster ); // processor task is not part of normal initialization
-    readyIdleTaskLock.release();
+    if ( &task.bound == NULL && readyQueue->initializeTasks() ) { // processor task is not part of normal initialization
+	readyIdleTaskLock.acquire();
+	readyQueue->removeInitialize( &(task.clusterRef), tasksOnCluster );
+	readyIdleTaskLock.release();
+    } // if
+    tasksOnClusterLock.release();
 } // uCluster::taskRemove
 
 
 void uCluster::taskReschedule( uBaseTask &task ) {
+  if ( ! readyQueue->initializeTasks() ) return;
+    tasksOnClusterLock.acquire();
     readyIdleTaskLock.acquire();
     readyQueue->rescheduleTask( &(task.clusterRef), tasksOnCluster );
     readyIdleTaskLock.release();
+    tasksOnClusterLock.release();
 } // uCluster::taskReschedule
 
 
@@ -343,6 +597,9 @@ void uCluster::processorRemove( uProcessor &processor ) {
     numProcessors -= 1;
     processorsOnCluster.remove( &(processor.processorRef) );
     processorsOnClusterLock.release();
+#ifdef __U_MULTI__
+    if ( workStealing ) readyQueueDrain( processor );	// no longer visible to thieves, so rehome its tasks
+#endif // __U_MULTI__
 } // uCluster::processorRemove
 
 
@@ -392,9 +649,12 @@ void uCluster::createCluster( unsigned int stackSize, const char *name ) {
 
     numProcessors = 0;
     idleProcessorsCnt = 0;
+    uringIO = false;
+    handoff = false;
 
     setName( name );
     setStackSize( stackSize );
+    setStackCache( uDefaultStackCache() );
 
 #if __U_LOCALDEBUGGER_H__
     if ( uLocalDebugger::uLocalDebuggerActive ) uLocalDebugger::uLocalDebuggerInstance->checkPoint();
@@ -427,22 +687,48 @@ void uCluster::createCluster( unsigned int stackSize, const char *name ) {
 } // uCluster::createCluster
 
 
-uCluster::uCluster( unsigned int stackSize, const char *name ) : globalRef( *this ), readyQueue( NULL ), wakeupList( *this ) {
+uCluster::uCluster( unsigned int stackSize, const char *name ) : globalRef( *this ), readyQueue( NULL ), workStealing( false ), wakeupList( *this ) {
     createCluster( stackSize, name );
 } // uCluster::uCluster
 
 
-uCluster::uCluster( const char *name ) : globalRef( *this ), readyQueue( NULL ), wakeupList( *this ) {
+uCluster::uCluster( const char *name ) : globalRef( *this ), readyQueue( NULL ), workStealing( false ), wakeupList( *this ) {
     createCluster( uDefaultStackSize(), name );
 } // uCluster::uCluster
 
 
-uCluster::uCluster( uBaseSchedule<uBaseTaskDL> &ReadyQueue, unsigned int stackSize, const char *name ) : globalRef( *this ), readyQueue( &ReadyQueue ), wakeupList( *this ) {
+uCluster::uCluster( uBaseSchedule<uBaseTaskDL> &ReadyQueue, unsigned int stackSize, const char *name ) : globalRef( *this ), readyQueue( &ReadyQueue ), workStealing( false ), wakeupList( *this ) {
     createCluster( stackSize, name );
 } // uCluster::uCluster
 
 
-uCluster::uCluster( uBaseSchedule<uBaseTaskDL> &ReadyQueue, const char *name ) : globalRef( *this ), readyQueue( &ReadyQueue ), wakeupList( *this ) {
+uCluster::uCluster( uBaseSchedule<uBaseTaskDL> &ReadyQueue, const char *name ) : globalRef( *this ), readyQueue( &ReadyQueue ), workStealing( false ), wakeupList( *this ) {
+    createCluster( uDefaultStackSize(), name );
+} // uCluster::uCluster
+
+
+// Per-processor ready queues are FIFO like the default scheduler, so they only work with it; priority schedulers need
+// a single global order. The uniprocessor kernel multiplexes all processors on one kernel thread, so there is no lock
+// contention to remove and the mode is ignored.
+
+uCluster::uCluster( ReadyQueueMode mode, unsigned int stackSize, const char *name ) : globalRef( *this ), readyQueue( NULL ),
+#ifdef __U_MULTI__
+	workStealing( mode == WorkStealingReadyQueue ),
+#else
+	workStealing( false ),
+#endif // __U_MULTI__
+	wakeupList( *this ) {
+    createCluster( stackSize, name );
+} // uCluster::uCluster
+
+
+uCluster::uCluster( ReadyQueueMode mode, const char *name ) : globalRef( *this ), readyQueue( NULL ),
+#ifdef __U_MULTI__
+	workStealing( mode == WorkStealingReadyQueue ),
+#else
+	workStealing( false ),
+#endif // __U_MULTI__
+	wakeupList( *this ) {
     createCluster( uDefaultStackSize(), name );
 } // uCluster::uCluster
 
@@ -541,6 +827,26 @@ int uCluster::select( int fd, int rwe, timeval *timeout ) {
 } // uCluster::select
 
 
+bool uCluster::setIOUring( bool enable ) {
+    bool prev = uringIO;
+#if defined( __U_IOURING__ )
+    uringIO = enable && NBIO->uringCreate();		// remains off if io_uring is unavailable
+#else
+    uringIO = false;
+#endif // __U_IOURING__
+    return prev;
+} // uCluster::setIOUring
+
+
+int uCluster::uring( UPP::uIOUringOp &op ) {
+#if defined( __U_IOURING__ )
+    return NBIO->uring( op );
+#else
+    return -ENOSYS;
+#endif // __U_IOURING__
+} // uCluster::uring
+
+
 // Local Variables: //
 // compile-command: "make install" //
 // End: //
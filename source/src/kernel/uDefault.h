@@ -69,19 +69,34 @@
 #define __U_DEFAULT_MAIN_STACK_SIZE__ 500000
 
 
+// Define the default number of free stacks a cluster keeps for reuse by coroutines and tasks subsequently created on the
+// cluster. Zero disables the stack cache.
+
+#define __U_DEFAULT_STACK_CACHE__ 64
+
+
 // Define the default number of processors created on the user cluster. May not be less than 1.
 
 #define __U_DEFAULT_PROCESSORS__ 1
 
 
+// Define whether a cluster waits for I/O on single file descriptors using epoll rather than select (Linux only).  epoll
+// keeps the interest set in the kernel, so a poll does not rescan descriptor masks and descriptors are not limited to
+// FD_SETSIZE.
+
+#define __U_DEFAULT_EPOLL__ true
+
+
 extern unsigned int uDefaultHeapExpansion();		// heap expansion size (bytes)
 extern unsigned int uDefaultMmapStart();		// cross over point to use mmap rather than buckets
 extern unsigned int uDefaultStackSize();		// cluster coroutine/task stack size (bytes)
 extern unsigned int uMainStackSize();			// uMain task stack size (bytes)
+extern unsigned int uDefaultStackCache();		// cluster free-stack cache size (stacks)
 extern unsigned int uDefaultSpin();			// processor spin time for idle task (context switches)
 extern unsigned int uDefaultPreemption();		// processor scheduling pre-emption durations (milliseconds)
 extern unsigned int uDefaultProcessors();		// number of processors created on the user cluster
 extern unsigned int uDefaultBlockingIOProcessors();	// number of blocking I/O processors created on the blocking I/O cluster
+extern bool uDefaultEpoll();				// cluster single-fd I/O waits use epoll rather than select
 extern void uStatistics();				// print user defined statistics on interrupt
 
 
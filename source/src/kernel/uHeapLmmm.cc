@@ -78,6 +78,9 @@ namespace UPP {
 #endif // FASTLOOKUP
 
     int uHeapManager::mmapFd = -1;
+#if defined( __U_MULTI__ )
+    __U_THREAD__ uHeapManager::ThreadCache uHeapManager::threadCache;
+#endif // __U_MULTI__
 #ifdef __U_DEBUG__
     unsigned long int uHeapManager::allocfree = 0;
 #endif // __U_DEBUG__
@@ -232,6 +235,89 @@ namespace UPP {
     } // uHeapManager::extend
 
 
+#if defined( __U_MULTI__ )
+    uHeapManager::ThreadCache *uHeapManager::threadCacheBoot() {
+	// Not inlined so the thread-local address is computed after interrupts are disabled, i.e., on the kernel thread
+	// that uses it.
+	THREAD_SETMEM( heapCache, &threadCache );
+	return &threadCache;
+    } // uHeapManager::threadCacheBoot
+
+    inline uHeapManager::ThreadCache *uHeapManager::threadCacheGet() {
+	// Must be called with interrupts disabled so the task cannot migrate to another kernel thread while using the
+	// cache.
+	ThreadCache *cache = (ThreadCache *)THREAD_GETMEM( heapCache );
+	if ( unlikely( cache == NULL ) ) cache = threadCacheBoot(); // first use by kernel thread ?
+	return unlikely( cache->finished ) ? NULL : cache;
+    } // uHeapManager::threadCacheGet
+
+
+    bool uHeapManager::refill( FreeHeader *freeElem, Magazine &magazine ) {
+	// Take a batch of blocks from the bucket, or carve a batch from the heap if the bucket is empty.
+	freeElem->lock.acquire();
+	Storage *blocks = freeElem->freeList;
+	if ( blocks != NULL ) {
+	    Storage *last = blocks;
+	    unsigned int n = 1;
+	    for ( ; n < MagazineBatch && last->header.kind.real.next != NULL; n += 1 ) {
+		last = last->header.kind.real.next;
+	    } // for
+	    freeElem->freeList = last->header.kind.real.next;
+	    freeElem->lock.release();
+	    last->header.kind.real.next = magazine.blocks;
+	    magazine.blocks = blocks;
+	    magazine.count += n;
+	    return true;
+	} // if
+	freeElem->lock.release();
+
+	char *area = (char *)extend( freeElem->blockSize * MagazineBatch ); // mutual exclusion on call
+      if ( area == NULL ) return false;
+	for ( unsigned int i = 0; i < MagazineBatch; i += 1 ) {
+	    Storage *block = (Storage *)(area + i * freeElem->blockSize);
+	    block->header.kind.real.next = magazine.blocks;
+	    magazine.blocks = block;
+	} // for
+	magazine.count += MagazineBatch;
+	return true;
+    } // uHeapManager::refill
+
+
+    void uHeapManager::flush( FreeHeader *freeElem, Magazine &magazine, unsigned int n ) {
+	// Return the first n blocks of the magazine to the bucket with one lock acquisition.
+	Storage *blocks = magazine.blocks;
+	Storage *last = blocks;
+	for ( unsigned int i = 1; i < n; i += 1 ) {
+	    last = last->header.kind.real.next;
+	} // for
+	magazine.blocks = last->header.kind.real.next;
+	magazine.count -= n;
+
+	freeElem->lock.acquire();
+	last->header.kind.real.next = freeElem->freeList;
+	freeElem->freeList = blocks;
+	freeElem->lock.release();
+    } // uHeapManager::flush
+
+
+    void uHeapManager::flushThread() {
+	// The kernel thread is terminating, so return its magazines, and subsequent allocations and frees on this thread
+	// use the buckets.
+	THREAD_GETMEM( This )->disableIntSpinLock();
+	ThreadCache *cache = threadCacheGet();
+	if ( cache != NULL ) {
+	    cache->finished = true;
+	    for ( unsigned int i = 0; i < MagazineBuckets; i += 1 ) {
+		if ( cache->magazines[i].count != 0 ) {
+		    flush( &freeLists[i], cache->magazines[i], cache->magazines[i].count );
+		} // if
+	    } // for
+	} // if
+	THREAD_GETMEM( This )->enableIntSpinLock();
+    } // uHeapManager::flushThread
+#endif // __U_MULTI__
+
+
     inline void *uHeapManager::doMalloc( size_t size ) {
 #ifdef __U_DEBUG_H__
 	uDebugPrt( "(uHeapManager &)%p.doMalloc( %zu )\n", this, size );
@@ -280,22 +366,42 @@ namespace UPP {
 #ifdef __U_DEBUG_H__
 	    uDebugPrt( "(uHeapManager &)%p.doMalloc, size after lookup:%zu\n", this, tsize );
 #endif // __U_DEBUG_H__
-    
-	    // Spin until the lock is acquired for this particular size of block.
 
-	    freeElem->lock.acquire();
-	    if ( likely( freeElem->freeList != NULL ) ) {
-		block = freeElem->freeList;		// remove node from stack
-		freeElem->freeList = block->header.kind.real.next;
-		freeElem->lock.release();
-	    } else {
-		freeElem->lock.release();
+	    block = NULL;
+#if defined( __U_MULTI__ )
+	    unsigned int bucket = freeElem - freeLists;
+	    if ( likely( bucket < MagazineBuckets ) ) { // small size => kernel-thread magazine
+		THREAD_GETMEM( This )->disableIntSpinLock();
+		ThreadCache *cache = threadCacheGet();
+		if ( likely( cache != NULL ) ) {
+		    Magazine &magazine = cache->magazines[bucket];
+		    if ( likely( magazine.count != 0 ) || refill( freeElem, magazine ) ) {
+			block = magazine.blocks;	// remove node from stack
+			magazine.blocks = block->header.kind.real.next;
+			magazine.count -= 1;
+		    } // if
+		} // if
+		THREAD_GETMEM( This )->enableIntSpinLock();
+	    } // if
+#endif // __U_MULTI__
+
+	    if ( unlikely( block == NULL ) ) {
+		// Spin until the lock is acquired for this particular size of block.
 
-		// Freelist for that size was empty, so carve it out of the heap if there's enough left, or get some more
-		// and then carve it off.
+		freeElem->lock.acquire();
+		if ( likely( freeElem->freeList != NULL ) ) {
+		    block = freeElem->freeList;		// remove node from stack
+		    freeElem->freeList = block->header.kind.real.next;
+		    freeElem->lock.release();
+		} else {
+		    freeElem->lock.release();
 
-		block = (Storage *)extend( tsize );	// mutual exclusion on call
-		if ( unlikely( block == NULL ) ) return NULL;
+		    // Freelist for that size was empty, so carve it out of the heap if there's enough left, or get some
+		    // more and then carve it off.
+
+		    block = (Storage *)extend( tsize );	// mutual exclusion on call
+		    if ( unlikely( block == NULL ) ) return NULL;
+		} // if
 	    } // if
 
 	    block->header.kind.real.home = freeElem;	// pointer back to free list of apropriate size
@@ -365,13 +471,38 @@ namespace UPP {
 	    uDebugPrt( "(uHeapManager &)%p.doFree( %p ) header:%p freeElem:%p\n", this, addr, &header, &freeElem );
 #endif // __U_DEBUG_H__
 
-	    freeElem->lock.acquire();			// acquire spin lock
+	    bool cached = false;
+#if defined( __U_MULTI__ )
 #ifdef __U_STATISTICS__
-	    free_storage += size;
+	    uFetchAdd( free_storage, size );		// magazines are not locked
 #endif // __U_STATISTICS__
-	    header->kind.real.next = freeElem->freeList; // push on stack
-	    freeElem->freeList = (Storage *)header;
-	    freeElem->lock.release();			// release spin lock
+	    unsigned int bucket = freeElem - freeLists;
+	    if ( likely( bucket < MagazineBuckets ) ) { // small size => kernel-thread magazine
+		THREAD_GETMEM( This )->disableIntSpinLock();
+		ThreadCache *cache = threadCacheGet();
+		if ( likely( cache != NULL ) ) {
+		    Magazine &magazine = cache->magazines[bucket];
+		    header->kind.real.next = magazine.blocks; // push on stack
+		    magazine.blocks = (Storage *)header;
+		    magazine.count += 1;
+		    if ( unlikely( magazine.count >= MagazineSize ) ) { // full ? => return batch to bucket
+			flush( freeElem, magazine, MagazineBatch );
+		    } // if
+		    cached = true;
+		} // if
+		THREAD_GETMEM( This )->enableIntSpinLock();
+	    } // if
+#endif // __U_MULTI__
+
+	    if ( unlikely( ! cached ) ) {
+		freeElem->lock.acquire();		// acquire spin lock
+#if defined( __U_STATISTICS__ ) && ! defined( __U_MULTI__ )
+		free_storage += size;
+#endif // __U_STATISTICS__ && ! __U_MULTI__
+		header->kind.real.next = freeElem->freeList; // push on stack
+		freeElem->freeList = (Storage *)header;
+		freeElem->lock.release();		// release spin lock
+	    } // if
 
 #ifdef __U_DEBUG_H__
 	    uDebugPrt( "(uHeapManager &)%p.doFree( %p ) returning free block in list 0x%zx\n", this, addr, size );
@@ -533,9 +664,18 @@ namespace UPP {
 	// application terminates. The heap's destructor does check for unreleased storage at this point. (The constructor
 	// for the heap is called on the first call to malloc.)
 
+#if defined( __U_MULTI__ )
+	uHeapManager::heapManagerInstance->flushThread(); // blocks cached by the boot thread are not allocated
+#endif // __U_MULTI__
 	uHeapManager::heapManagerInstance->uHeapManager::~uHeapManager();
     } // uHeapControl::finishup
 
+    void uHeapControl::finishThread() {
+#if defined( __U_MULTI__ )
+	uHeapManager::heapManagerInstance->flushThread();
+#endif // __U_MULTI__
+    } // uHeapControl::finishThread
+
     void uHeapControl::prepareTask( uBaseTask *task ) {
     } // uHeapControl::prepareTask
 
@@ -76,7 +76,7 @@ namespace UPP {
 	friend uMallReturnType ::malloc_usable_size( void *addr ) __THROW; // access: Header, FreeHeader
 	friend void ::malloc_stats() __THROW;
 	friend int ::malloc_stats_fd( int fd ) __THROW;
-	friend class uHeapControl;			// access: heapManagerInstance, boot
+	friend class uHeapControl;			// access: heapManagerInstance, boot, flushThread
 #ifdef __U_STATISTICS__
 	friend void UPP::Statistics::print();
 #endif // __U_STATISTICS__
@@ -116,9 +116,9 @@ namespace UPP {
 	}; // Storage
 
 	struct FreeHeader {
-	    uSpinLock lock;				// must be first field for alignment
 	    size_t blockSize;				// size of allocations on this list
 	    Storage *freeList;
+	    uKernelLock lock;				// padded to a cache line, which separates adjacent buckets
 
 	    bool operator<( const FreeHeader &a2 ) const { return blockSize < a2.blockSize; }
 	}; // FreeHeader
@@ -127,8 +127,29 @@ namespace UPP {
 #ifdef FASTLOOKUP
 	       LookupSizes = 65536,			// number of fast lookup sizs
 #endif // FASTLOOKUP
+#if defined( __U_MULTI__ )
+	       MagazineBuckets = 25,			// buckets with a kernel-thread magazine (sizes <= 1024)
+	       MagazineSize = 32,			// maximum blocks in a magazine
+	       MagazineBatch = 16,			// blocks moved between a magazine and its bucket at a time
+#endif // __U_MULTI__
 	};
 
+#if defined( __U_MULTI__ )
+	// Each kernel thread keeps a magazine of free blocks for the small bucket sizes so most allocations and frees do
+	// not touch the shared buckets. Blocks move between a magazine and its bucket in batches under one lock.
+	struct Magazine {
+	    Storage *blocks;				// stack of free blocks
+	    unsigned int count;				// number of blocks in magazine
+	}; // Magazine
+
+	struct ThreadCache {
+	    Magazine magazines[MagazineBuckets];
+	    bool finished;				// kernel thread terminating => use buckets directly
+	}; // ThreadCache
+
+	static __U_THREAD__ ThreadCache threadCache;	// kernel-thread magazines, zero filled
+#endif // __U_MULTI__
+
 	static uHeapManager *heapManagerInstance;	// pointer to heap manager object
 	static size_t pageSize;				// architecture pagesize
 	static size_t heapExpand;			// sbrk advance
@@ -185,6 +206,13 @@ namespace UPP {
 
 	bool headers( const char *name, void *addr, Storage::Header *&header, FreeHeader *&freeElem, size_t &size, size_t &alignment );
 	void *extend( size_t size );
+#if defined( __U_MULTI__ )
+	static ThreadCache *threadCacheBoot() __attribute__(( noinline ));
+	static ThreadCache *threadCacheGet();
+	bool refill( FreeHeader *freeElem, Magazine &magazine );
+	void flush( FreeHeader *freeElem, Magazine &magazine, unsigned int n );
+	void flushThread();
+#endif // __U_MULTI__
 	void *doMalloc( size_t size );
 	void doFree( void *addr );
 	size_t checkFree( bool prt = false );
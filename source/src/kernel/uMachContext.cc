@@ -38,6 +38,7 @@
 
 #include <cerrno>
 #include <unistd.h>					// write
+#include <sys/mman.h>					// mmap, munmap, madvise
 
 #if defined( __sparc__ ) || defined( __x86_64__ ) || defined( __ia64__ )
 extern "C" void uInvokeStub( UPP::uMachContext * );
@@ -120,6 +121,10 @@ namespace UPP {
 	This.currCoroutine->setState( uBaseCoroutine::Active ); // set state of next coroutine to active
 	This.setState( uBaseTask::Running );
 
+	// A new task may be switched to directly by a blocking task rather than by the kernel, so complete the blocking
+	// task's schedule operation before enabling interrupts.
+	uProcessorKernel::switchComplete();
+
 	// At this point, execution is on the stack of the new coroutine or task that has just been switched to by the
 	// kernel.  Therefore, interrupts can legitimately occur now.
 	THREAD_GETMEM( This )->enableInterrupts();
@@ -292,9 +297,9 @@ namespace UPP {
 	((uContext_t *)context)->SP = (char *)base - sizeof( FakeStack );
 	((uContext_t *)context)->BSP = (char*)limit + 16;
 	sigemptyset( &((uContext_t *)context)->sigMask );
-#ifdef __U_MULTI__
+#if defined( __U_MULTI__ ) && ! defined( __U_PROCESSOR_TIMER__ )
 	sigaddset( &((uContext_t *)context)->sigMask, SIGALRM );
-#endif // __U_MULTI__
+#endif // __U_MULTI__ && ! __U_PROCESSOR_TIMER__
 	memset( ((uContext_t *)context)->SP, 0, sizeof( FakeStack ) );
 	((FakeStack *)(((uContext_t *)context)->SP))->preserved.b0 = rtnAdr( (void (*)())uInvokeStub );
 	((FakeStack *)(((uContext_t *)context)->SP))->preserved.r1 = gpAdr( (void (*)())uInvokeStub );
@@ -349,6 +354,119 @@ namespace UPP {
     } // uMachContext::startHere
 
 
+    uStackCache::~uStackCache() {
+	while ( stacks != NULL ) {
+	    Stack *stack = stacks;
+	    stacks = stack->next;
+	    unmap( (char *)stack + sizeof(Stack) - stack->length, stack->length );
+	} // while
+    } // uStackCache::~uStackCache
+
+
+    void *uStackCache::map( size_t length ) {
+	// Reserve address space only; pages are committed when the stack grows into them.
+	void *storage = ::mmap( NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS
+#ifdef MAP_NORESERVE
+				| MAP_NORESERVE
+#endif // MAP_NORESERVE
+				, -1, 0 );
+	if ( storage == MAP_FAILED ) return NULL;
+#ifdef __U_DEBUG__
+	if ( ::mprotect( storage, uMachContext::pageSize, PROT_NONE ) == -1 ) { // guard page
+	    uAbort( "(uStackCache)::map() : internal error, mprotect failure, error(%d) %s.", errno, strerror( errno ) );
+	} // if
+#endif // __U_DEBUG__
+	return storage;
+    } // uStackCache::map
+
+
+    void uStackCache::unmap( void *storage, size_t length ) {
+	if ( ::munmap( storage, length ) == -1 ) {
+	    uAbort( "(uStackCache)::unmap( %p, %zd ) : internal error, munmap failure, error(%d) %s.", storage, length, errno, strerror( errno ) );
+	} // if
+    } // uStackCache::unmap
+
+
+    void *uStackCache::get( size_t length ) {
+	if ( stacks == NULL ) return NULL;		// optimize out lock if possible
+	uCSpinLock dummy( lock );
+	for ( Stack **prev = &stacks; *prev != NULL; prev = &(*prev)->next ) {
+	    Stack *stack = *prev;
+	    if ( stack->length == length ) {		// same size ?
+		*prev = stack->next;
+		count -= 1;
+		return (char *)stack + sizeof(Stack) - length;
+	    } // if
+	} // for
+	return NULL;
+    } // uStackCache::get
+
+
+    void uStackCache::put( void *storage, size_t length ) {
+	Stack *stack = node( storage, length );
+	stack->length = length;
+	stack->trimmed = false;
+	lock.acquire();
+	if ( count < limit ) {
+	    stack->next = stacks;
+	    stacks = stack;
+	    count += 1;
+	    untrimmed = true;
+	    lock.release();
+	} else {
+	    lock.release();
+	    unmap( storage, length );
+	} // if
+    } // uStackCache::put
+
+
+    void uStackCache::trim() {
+	if ( ! untrimmed ) return;			// optimize out lock if possible
+#ifdef __U_DEBUG__
+	size_t guard = uMachContext::pageSize;
+#else
+	size_t guard = 0;
+#endif // __U_DEBUG__
+	uCSpinLock dummy( lock );
+	for ( Stack *stack = stacks; stack != NULL; stack = stack->next ) {
+	    if ( stack->trimmed ) continue;
+	    // Return all pages except the guard page and the last page, which holds the list node.
+	    char *storage = (char *)stack + sizeof(Stack) - stack->length;
+	    if ( stack->length > guard + uMachContext::pageSize ) {
+		size_t length = stack->length - guard - uMachContext::pageSize;
+#ifdef MADV_FREE
+		if ( ::madvise( storage + guard, length, MADV_FREE ) == -1 ) // lazy, not on older kernels
+#endif // MADV_FREE
+		    ::madvise( storage + guard, length, MADV_DONTNEED );
+	    } // if
+	    stack->trimmed = true;
+	} // for
+	untrimmed = false;
+    } // uStackCache::trim
+
+
+    unsigned int uStackCache::setLimit( unsigned int limit ) {
+	Stack *excess = NULL;
+	lock.acquire();
+	unsigned int prev = uStackCache::limit;
+	uStackCache::limit = limit;
+	while ( count > limit ) {			// remove extra stacks
+	    Stack *stack = stacks;
+	    stacks = stack->next;
+	    stack->next = excess;
+	    excess = stack;
+	    count -= 1;
+	} // while
+	lock.release();
+	while ( excess != NULL ) {			// unmap outside of lock
+	    Stack *stack = excess;
+	    excess = stack->next;
+	    unmap( (char *)stack + sizeof(Stack) - stack->length, stack->length );
+	} // while
+	return prev;
+    } // uStackCache::setLimit
+
+
     /**************************************************************
 	,-----------------. \
 	|                 | |
@@ -360,36 +478,42 @@ namespace UPP {
 	|    task stack   | } size (multiple of 16)
 	|                 | |
 	`-----------------' / <--- limit (16 byte align)
-	0/8                   <--- storage
-	,-----------------.
+	,-----------------.   <--- storage (page align)
 	|   guard page    |   debug only
 	| write protected |
-	`-----------------'   <--- 4/8/16K alignment
+	`-----------------'
     **************************************************************/
 
+    size_t uMachContext::storageLength() const {
+	// mmap storage is rounded to a page boundary, and includes at least one page above the guard page for the list
+	// node when the stack is cached
+	size_t length = uCeiling( uCeiling( sizeof(__U_CONTEXT_T__), 8 ) + size, pageSize );
+#ifdef __U_DEBUG__
+	length += pageSize;				// guard page
+#endif // __U_DEBUG__
+	return length;
+    } // uMachContext::storageLength
+
+
     void uMachContext::createContext( unsigned int storageSize ) { // used by all constructors
 	size_t cxtSize = uCeiling( sizeof(__U_CONTEXT_T__), 8 ); // minimum alignment
 
 	if ( storage == NULL ) {
 	    userStack = false;
 	    size = uCeiling( storageSize, 16 );
-	    // use malloc/memalign because "new" raises an exception for out-of-memory
-#ifdef __U_DEBUG__
-	    storage = memalign( pageSize, cxtSize + size + pageSize );
-	    if ( ::mprotect( storage, pageSize, PROT_NONE ) == -1 ) {
-		uAbort( "(uMachContext &)%p.createContext() : internal error, mprotect failure, error(%d) %s.", this, errno, strerror( errno ) );
+	    size_t length = storageLength();
+	    // reuse a stack freed on this cluster, otherwise reserve new storage; the cache is unavailable during kernel
+	    // boot and shutdown
+	    if ( uKernelModule::systemTask == NULL || ( storage = uThisCluster().stackCache.get( length ) ) == NULL ) {
+		storage = uStackCache::map( length );
 	    } // if
-#else
-	    // assume malloc has 8 byte alignment so add 8 to allow rounding up to 16 byte alignment
-	    storage = malloc( cxtSize + size + 8 );
-#endif // __U_DEBUG__
 	    if ( storage == NULL ) {
 		uAbort( "Attempt to allocate %d bytes of storage for coroutine or task execution-state but insufficient memory available.", size );
 	    } // if
 #ifdef __U_DEBUG__
 	    limit = (char *)storage + pageSize;
 #else
-	    limit = (char *)uCeiling( (unsigned long)storage, 16 ); // minimum alignment
+	    limit = storage;				// page alignment
 #endif // __U_DEBUG__
 	} else {
 #ifdef __U_DEBUG__
@@ -416,6 +540,16 @@ namespace UPP {
     } // uMachContext::createContext
 
 
+    void uMachContext::freeContext() {
+	size_t length = storageLength();
+	if ( uKernelModule::systemTask == NULL ) {	// kernel boot or shutdown ?
+	    uStackCache::unmap( storage, length );
+	} else {
+	    uThisCluster().stackCache.put( storage, length ); // guard page remains protected for reuse
+	} // if
+    } // uMachContext::freeContext
+
+
     void *uMachContext::stackPointer() const {
 	if ( &uThisCoroutine() == this ) {		// accessing myself ?
 	    void *sp;					// use my current stack value
@@ -47,9 +47,16 @@ using std::min;
 #include <cerrno>
 #include <sys/socket.h>
 #include <sys/poll.h>
+#include <unistd.h>					// close
 #if defined( __linux__ ) || defined( __freebsd__ )
 #include <sys/param.h>					// howmany
 #endif
+#if defined( __U_IOURING__ )
+#include <linux/io_uring.h>
+#include <sys/mman.h>					// mmap, munmap
+#include <sys/syscall.h>				// __NR_io_uring_*
+#include <stdint.h>					// uintptr_t
+#endif // __U_IOURING__
 
 
 namespace UPP {
@@ -190,13 +197,33 @@ namespace UPP {
 
 
     void uNBIO::checkIOStart() {
+#if defined( __U_IOURING__ )
+	if ( ringUnsubmitted != 0 ) uringSubmit();	// submit operations queued since the last poll with one call
+#endif // __U_IOURING__
+
 	// Combine the single and multiple master masks to form the master mask.
 
 	maxFD = max( smaxFD, mmaxFD );
-	assert( maxFD != 0 );
 #ifdef __U_STATISTICS__
 	if ( maxFD > Statistics::select_maxFD ) Statistics::select_maxFD = maxFD;
 #endif // __U_STATISTICS__
+#if defined( __U_EPOLL__ )
+	if ( epollFD != -1 ) {				// single fds in epoll set ?
+	  if ( mmaxFD == 0 ) { maxFD = 0; return; }	// no multiple fds => wait directly on epoll set
+
+	    // Multiple fds use the master masks with the epoll set added to the read mask, so the select also wakes
+	    // for the single fds.
+	    maxFD = max( mmaxFD, (unsigned int)epollFD + 1 );
+	    unsigned int tmasks = howmany( maxFD, NFDBITS );
+	    for ( unsigned int i = 0; i < tmasks; i += 1 ) mRFDs.fds_bits[i] = mrfds.fds_bits[i];
+	    for ( unsigned int i = 0; i < tmasks; i += 1 ) mWFDs.fds_bits[i] = mwfds.fds_bits[i];
+	    if ( efdsUsed )
+		for ( unsigned int i = 0; i < tmasks; i += 1 ) mEFDs.fds_bits[i] = mefds.fds_bits[i];
+	    FD_SET( epollFD, &mRFDs );
+	    return;
+	} // if
+#endif // __U_EPOLL__
+	assert( maxFD != 0 );
 	unsigned int minFD = min( smaxFD, mmaxFD );
 	unsigned int i;
 	unsigned int tmasks = howmany( minFD, NFDBITS );
@@ -225,10 +252,30 @@ namespace UPP {
 	static timespec timeout_ = { 0, 0 };
 
 #ifdef __U_STATISTICS__
-	uFetchAdd( Statistics::select_syscalls, 1 );
+	uFetchAdd( Statistics::counters().select_syscalls, 1 );
 	Statistics::select_pending = pending;
 #endif // __U_STATISTICS__
 	assert( THREAD_GETMEM( disableInt ) );
+#if defined( __U_EPOLL__ )
+	if ( epollFD != -1 ) {
+	    if ( maxFD == 0 ) {				// only single fds ?
+		descriptors = ::epoll_pwait( epollFD, epollEvents, EpollMaxEvents, selectBlock ? -1 : 0, old_mask );
+		epollCnt = max( descriptors, 0 );
+	    } else {
+		descriptors = ::pselect( maxFD, &mRFDs, &mWFDs,
+					 ! efdsUsed ? NULL : &mEFDs, // no exceptions ?
+					 selectBlock ? NULL : &timeout_, old_mask ); // poll or block ?
+		epollCnt = 0;
+		if ( descriptors > 0 && FD_ISSET( epollFD, &mRFDs ) ) { // single fds ready ?
+		    FD_CLR( epollFD, &mRFDs );
+		    epollCnt = max( ::epoll_wait( epollFD, epollEvents, EpollMaxEvents, 0 ), 0 );
+		    descriptors += epollCnt - 1;	// replace epoll set by its ready fds
+		} // if
+	    } // if
+	    IOPollerPid = (uPid_t)-1;
+	    return errno;
+	} // if
+#endif // __U_EPOLL__
 	descriptors = ::pselect( maxFD, &mRFDs, &mWFDs,
 				 ! efdsUsed ? NULL : &mEFDs, // no exceptions ?
 				 selectBlock ? NULL : &timeout_, old_mask ); // poll or block ?
@@ -288,6 +335,9 @@ namespace UPP {
 		// not signal the one blocked on select (by not putting it on the idle list), otherwise there can be a
 		// large number of unnecessary EINTR restarts for the select.
 
+#if defined( __U_PROCESSOR_FUTEX__ )
+		uThisProcessor().parkState = uProcessor::Polling; // wakers must signal rather than unpark
+#endif // __U_PROCESSOR_FUTEX__
 		if ( uThisCluster().getProcessors() == 1 )
 		    uThisCluster().makeProcessorIdle( uThisProcessor() );
 		uThisCluster().readyIdleTaskLock.release();
@@ -303,7 +353,7 @@ namespace UPP {
 		    // set IOPollerPid so this processor is woken up by arriving I/O requests or timed-out I/O requests
 		    IOPollerPid = uThisProcessor().getPid();
 #ifdef __U_STATISTICS__
-		    uFetchAdd( Statistics::select_blocking, 1 );
+		    uFetchAdd( Statistics::counters().select_blocking, 1 );
 #endif // __U_STATISTICS__
 
 #if ! defined( __U_MULTI__ )
@@ -311,6 +361,14 @@ namespace UPP {
 #endif // ! __U_MULTI__
 
 		if ( timeoutOccurred ) selectBlock = false;
+#if defined( __U_IOURING__ )
+		// An operation queued after checkIOStart is not submitted until the next poll, so do not block. The fence
+		// pairs with the one in initUring, so either the poller sees the operation or the task sees IOPollerPid.
+		if ( ring != NULL ) {
+		    __sync_synchronize();
+		    if ( ringUnsubmitted != 0 ) selectBlock = false;
+		} // if
+#endif // __U_IOURING__
 
 		terrno = select( &old_mask );
 
@@ -318,6 +376,9 @@ namespace UPP {
 		    uAbort( "internal error, sigprocmask" );
 		} // if
 
+#if defined( __U_PROCESSOR_FUTEX__ )
+		uThisProcessor().parkState = uProcessor::Active;
+#endif // __U_PROCESSOR_FUTEX__
 		if ( uThisProcessor().idle() )
 		    uThisCluster().makeProcessorActive( uThisProcessor() );
 	    } // if
@@ -338,6 +399,14 @@ namespace UPP {
     void uNBIO::performIO( int fd, NBIOnode *p, uSequence<NBIOnode> &pendingIO, int cnt ) {
 	p->smfd.sfd.closure->wrapper();
 	if ( p->smfd.sfd.closure->retcode == -1 && p->smfd.sfd.closure->errno_ == U_EWOULDBLOCK ) {
+#if defined( __U_EPOLL__ )
+	    if ( epollFD != -1 ) {
+		EpollFd &efd = epollFds[fd];
+		efd.ready &= ~*p->smfd.sfd.uRWE;	// remove events so no other task is woken
+		if ( efd.armed == 0 ) efd.rearm |= *p->smfd.sfd.uRWE; // fd disarmed by last poll ? => rearm for task
+		return;
+	    } // if
+#endif // __U_EPOLL__
 	    if ( *p->smfd.sfd.uRWE & uCluster::ReadSelect ) {
 		FD_CLR( fd, &mRFDs );			// remove bit from master mask so no other task is woken
 		FD_SET( fd, &srfds );			// reset single master for pending tasks on next select
@@ -370,19 +439,27 @@ namespace UPP {
 		   this, p->pendingTask->getName(), p->pendingTask, fd, *p->smfd.sfd.uRWE );
 #endif // __U_DEBUG_H__
 
-	if ( (*p->smfd.sfd.uRWE & uCluster::ReadSelect) && FD_ISSET( fd, &mRFDs ) ) {
-	    temp |= uCluster::ReadSelect;
-	    cnt += 1;
-	} // if
-	if ( (*p->smfd.sfd.uRWE & uCluster::WriteSelect ) && FD_ISSET( fd, &mWFDs ) ) {
-	    temp |= uCluster::WriteSelect;
-	    cnt += 1;
-	} // if
-	if ( efdsUsed )
-	    if ( (*p->smfd.sfd.uRWE & uCluster::ExceptSelect) && FD_ISSET( fd, &mEFDs ) ) {
-		temp |= uCluster::ExceptSelect;
+#if defined( __U_EPOLL__ )
+	if ( epollFD != -1 ) {				// events recorded for fd by last poll
+	    temp = *p->smfd.sfd.uRWE & epollFds[fd].ready;
+	    cnt = countBits( temp );
+	} else
+#endif // __U_EPOLL__
+	{
+	    if ( (*p->smfd.sfd.uRWE & uCluster::ReadSelect) && FD_ISSET( fd, &mRFDs ) ) {
+		temp |= uCluster::ReadSelect;
 		cnt += 1;
 	    } // if
+	    if ( (*p->smfd.sfd.uRWE & uCluster::WriteSelect ) && FD_ISSET( fd, &mWFDs ) ) {
+		temp |= uCluster::WriteSelect;
+		cnt += 1;
+	    } // if
+	    if ( efdsUsed )
+		if ( (*p->smfd.sfd.uRWE & uCluster::ExceptSelect) && FD_ISSET( fd, &mEFDs ) ) {
+		    temp |= uCluster::ExceptSelect;
+		    cnt += 1;
+		} // if
+	} // if
 
 	// cnt == 0 => master mask-bit turned off after executing the wrapper for a prior task
 	if ( cnt != 0 ) {				// I/O possible for task so perform operation on behalf of waiting task
@@ -396,13 +473,17 @@ namespace UPP {
 	    p->nfds = cnt;				// set return value
 	    p->pending.V();				// wake up waiting task (empty for IOPoller)
 	    pending -= 1;
+#if defined( __U_EPOLL__ )
+	} else if ( epollFD != -1 && epollFds[fd].armed == 0 ) { // fd disarmed by last poll ? => rearm for task
+	    epollFds[fd].rearm |= *p->smfd.sfd.uRWE;
+#endif // __U_EPOLL__
 	} // if
     } // uNBIO::checkSfds
 
 
     void uNBIO::unblockFD( uSequence<NBIOnode> &pendingIO ) {
 #ifdef __U_STATISTICS__
-	uFetchAdd( Statistics::iopoller_exchange, 1 );
+	uFetchAdd( Statistics::counters().iopoller_exchange, 1 );
 #endif // __U_STATISTICS__
 	NBIOnode *p = pendingIO.head();
 	IOPoller = p->pendingTask;			// next poller task
@@ -414,6 +495,402 @@ namespace UPP {
     } // uNBIO::unblockFD
 
 
+    uSequence<uNBIO::NBIOnode> &uNBIO::pendingIOSfd( unsigned int fd ) {
+#if defined( __U_EPOLL__ )
+	if ( epollFD != -1 ) return epollFds[fd].pendingIO;
+#endif // __U_EPOLL__
+	return pendingIOSfds[fd];
+    } // uNBIO::pendingIOSfd
+
+
+#if defined( __U_EPOLL__ )
+    int uNBIO::epollArm( int fd, unsigned int rwe ) {
+	EpollFd &efd = epollFds[fd];
+	epoll_event ev;
+	ev.events = EPOLLONESHOT |
+	    ( rwe & uCluster::ReadSelect ? EPOLLIN : 0 ) |
+	    ( rwe & uCluster::WriteSelect ? EPOLLOUT : 0 ) |
+	    ( rwe & uCluster::ExceptSelect ? EPOLLPRI : 0 );
+	ev.data.u64 = 0;
+	ev.data.fd = fd;
+
+	// The fd stays in the epoll set after its event so it is rearmed with a modify. A closed fd is implicitly removed
+	// from the set, so a modify on a reused fd number fails and the fd is added again.
+	int op = efd.registered ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+	if ( ::epoll_ctl( epollFD, op, fd, &ev ) == -1 ) {
+	    if ( errno == ENOENT && op == EPOLL_CTL_MOD ) op = EPOLL_CTL_ADD;
+	    else if ( errno == EEXIST && op == EPOLL_CTL_ADD ) op = EPOLL_CTL_MOD;
+	    else op = -1;
+	    if ( op == -1 || ::epoll_ctl( epollFD, op, fd, &ev ) == -1 ) {
+#ifdef __U_DEBUG_H__
+		uDebugPrt( "(uNBIO &)%p.epollArm, fd %d cannot be armed, errno:%d %s\n", this, fd, errno, strerror( errno ) );
+#endif // __U_DEBUG_H__
+		efd.registered = false;
+		efd.armed = 0;
+		return errno;
+	    } // if
+	} // if
+	efd.registered = true;
+	efd.armed = rwe;
+	return 0;
+    } // uNBIO::epollArm
+
+
+    void uNBIO::epollGrow( unsigned int fd ) {
+	unsigned int size = max( fd + 1, epollFdsSize * 2 );
+	EpollFd *fds = new EpollFd[size];
+	for ( unsigned int i = 0; i < epollFdsSize; i += 1 ) { // move state to larger table
+	    fds[i].pendingIO.transfer( epollFds[i].pendingIO );
+	    fds[i].armed = epollFds[i].armed;
+	    fds[i].ready = epollFds[i].ready;
+	    fds[i].rearm = epollFds[i].rearm;
+	    fds[i].registered = epollFds[i].registered;
+	} // for
+	delete [] epollFds;
+	epollFds = fds;
+	epollFdsSize = size;
+    } // uNBIO::epollGrow
+
+
+    void uNBIO::epollCheckSfds() {
+	NBIOnode *p;
+
+	for ( int i = 0; i < epollCnt; i += 1 ) {	// single fds with no timeout
+	    int fd = epollEvents[i].data.fd;
+	    EpollFd &efd = epollFds[fd];
+
+	    // process each task waiting for this fd's events, list can be empty due to timeout
+	    for ( uSeqIter<NBIOnode> iter( efd.pendingIO ); iter >> p; ) {
+		checkSfds( fd, p, efd.pendingIO );
+	    } // for
+	    efd.ready = 0;
+
+	    if ( efd.rearm != 0 ) {			// tasks still waiting ?
+		if ( epollArm( fd, efd.rearm ) != 0 ) {
+		    // fd closed while tasks are waiting, so wake them to retry their I/O and receive the error
+		    for ( uSeqIter<NBIOnode> iter( efd.pendingIO ); iter >> p; ) {
+			performIO( fd, p, efd.pendingIO, -1 );
+		    } // for
+		} // if
+		efd.rearm = 0;
+	    } // if
+	} // for
+	epollCnt = 0;
+    } // uNBIO::epollCheckSfds
+#endif // __U_EPOLL__
+
+
+#if defined( __U_IOURING__ )
+#ifndef __NR_io_uring_setup				// older libc headers, numbers are the same on all architectures
+#define __NR_io_uring_setup 425
+#define __NR_io_uring_enter 426
+#define __NR_io_uring_register 427
+#endif // ! __NR_io_uring_setup
+
+    struct uNBIO::IOUring {
+	enum { Entries = 256 };				// submission ring size, completion ring is twice as large
+
+	void *sqRing, *cqRing;				// mapped rings, same mapping if kernel supports single mmap
+	size_t sqRingSize, cqRingSize, sqesSize;
+	unsigned int *sqHead, *sqTail, *sqMask, *sqEntries, *sqFlags, *sqArray;
+	unsigned int *cqHead, *cqTail, *cqMask;
+	io_uring_sqe *sqes;
+	io_uring_cqe *cqes;
+	unsigned int sqLocalTail;			// next free submission entry
+    }; // uNBIO::IOUring
+
+
+    bool uNBIO::uringCreate() {
+      if ( ring != NULL ) return true;			// already created by another cluster (uniprocessor) ?
+	// A completion must wake the poller, which only happens when the poller blocks in the epoll set.
+      if ( epollFD == -1 ) return false;
+
+	io_uring_params params;
+	memset( &params, 0, sizeof(params) );
+	int fd = ::syscall( __NR_io_uring_setup, IOUring::Entries, &params );
+      if ( fd == -1 ) return false;			// kernel without io_uring, or disabled
+
+	// Operations use the current file position and the kernel must not drop completions when the completion ring
+	// is full, otherwise a waiting task is never woken.
+	static const unsigned char required[] = { IORING_OP_READ, IORING_OP_WRITE, IORING_OP_READV, IORING_OP_WRITEV,
+						  IORING_OP_RECV, IORING_OP_SEND, IORING_OP_RECVMSG, IORING_OP_SENDMSG, IORING_OP_ACCEPT,
+						  IORING_OP_SPLICE };
+	bool supported = ( params.features & IORING_FEAT_RW_CUR_POS ) && ( params.features & IORING_FEAT_NODROP );
+	if ( supported ) {
+	    union {
+		io_uring_probe probe;
+		char storage[sizeof(io_uring_probe) + IORING_OP_LAST * sizeof(io_uring_probe_op)];
+	    } p;
+	    memset( &p, 0, sizeof(p) );
+	    if ( ::syscall( __NR_io_uring_register, fd, IORING_REGISTER_PROBE, &p.probe, IORING_OP_LAST ) == -1 ) {
+		supported = false;
+	    } else {
+		for ( unsigned int i = 0; i < sizeof(required) / sizeof(required[0]); i += 1 ) {
+		    if ( required[i] > p.probe.last_op || ! ( p.probe.ops[required[i]].flags & IO_URING_OP_SUPPORTED ) ) supported = false;
+		} // for
+	    } // if
+	} // if
+
+	IOUring *r = new IOUring;
+	r->sqRing = r->cqRing = MAP_FAILED;
+	r->sqes = (io_uring_sqe *)MAP_FAILED;
+	if ( supported ) {
+	    r->sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+	    r->cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+	    if ( params.features & IORING_FEAT_SINGLE_MMAP ) r->sqRingSize = r->cqRingSize = max( r->sqRingSize, r->cqRingSize );
+	    r->sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+
+	    r->sqRing = ::mmap( NULL, r->sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING );
+	    if ( params.features & IORING_FEAT_SINGLE_MMAP ) {
+		r->cqRing = r->sqRing;
+	    } else {
+		r->cqRing = ::mmap( NULL, r->cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING );
+	    } // if
+	    r->sqes = (io_uring_sqe *)::mmap( NULL, r->sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES );
+	} // if
+
+	epoll_event ev;
+	ev.events = EPOLLIN;				// level triggered, ready while completions are unreaped
+	ev.data.u64 = 0;
+	ev.data.fd = fd;
+	if ( ! supported || r->sqRing == MAP_FAILED || r->cqRing == MAP_FAILED || r->sqes == MAP_FAILED ||
+	     ::epoll_ctl( epollFD, EPOLL_CTL_ADD, fd, &ev ) == -1 ) {
+#ifdef __U_DEBUG_H__
+	    uDebugPrt( "(uNBIO &)%p.uringCreate, io_uring unavailable\n", this );
+#endif // __U_DEBUG_H__
+	    if ( r->sqes != MAP_FAILED ) ::munmap( r->sqes, r->sqesSize );
+	    if ( r->cqRing != MAP_FAILED && r->cqRing != r->sqRing ) ::munmap( r->cqRing, r->cqRingSize );
+	    if ( r->sqRing != MAP_FAILED ) ::munmap( r->sqRing, r->sqRingSize );
+	    delete r;
+	    ::close( fd );
+	    return false;
+	} // if
+
+	char *sq = (char *)r->sqRing, *cq = (char *)r->cqRing;
+	r->sqHead = (unsigned int *)(sq + params.sq_off.head);
+	r->sqTail = (unsigned int *)(sq + params.sq_off.tail);
+	r->sqMask = (unsigned int *)(sq + params.sq_off.ring_mask);
+	r->sqEntries = (unsigned int *)(sq + params.sq_off.ring_entries);
+	r->sqFlags = (unsigned int *)(sq + params.sq_off.flags);
+	r->sqArray = (unsigned int *)(sq + params.sq_off.array);
+	r->cqHead = (unsigned int *)(cq + params.cq_off.head);
+	r->cqTail = (unsigned int *)(cq + params.cq_off.tail);
+	r->cqMask = (unsigned int *)(cq + params.cq_off.ring_mask);
+	r->cqes = (io_uring_cqe *)(cq + params.cq_off.cqes);
+	r->sqLocalTail = *r->sqTail;
+
+	ringFD = fd;
+	ring = r;
+	return true;
+    } // uNBIO::uringCreate
+
+
+    void uNBIO::uringSubmit() {
+	while ( ringUnsubmitted != 0 ) {
+	    int submitted = ::syscall( __NR_io_uring_enter, ringFD, ringUnsubmitted, 0, 0, NULL, 0 );
+#ifdef __U_STATISTICS__
+	    uFetchAdd( Statistics::counters().uring_enters, 1 );
+#endif // __U_STATISTICS__
+	    if ( submitted == -1 ) {
+	      if ( errno == EINTR ) continue;		// timer interrupt ?
+#ifdef __U_DEBUG_H__
+		uDebugPrt( "(uNBIO &)%p.uringSubmit, submit deferred, errno:%d %s\n", this, errno, strerror( errno ) );
+#endif // __U_DEBUG_H__
+		break;					// EAGAIN/EBUSY, kernel short of resources => resubmit on next poll
+	    } // if
+	  if ( submitted == 0 ) break;
+	    ringUnsubmitted -= submitted;
+	} // while
+    } // uNBIO::uringSubmit
+
+
+    void uNBIO::uringReap() {
+	IOUring &r = *ring;
+	unsigned int head = *r.cqHead;			// only modified here
+
+	for ( ;; ) {
+	    unsigned int tail = __atomic_load_n( r.cqTail, __ATOMIC_ACQUIRE );
+	    if ( head == tail ) {			// no completions ?
+		// Completions that did not fit in the completion ring are held by the kernel and flushed by an enter.
+	      if ( ! ( __atomic_load_n( r.sqFlags, __ATOMIC_RELAXED ) & IORING_SQ_CQ_OVERFLOW ) ) break;
+		::syscall( __NR_io_uring_enter, ringFD, 0, 0, IORING_ENTER_GETEVENTS, NULL, 0 );
+	      if ( head == __atomic_load_n( r.cqTail, __ATOMIC_ACQUIRE ) ) break;
+		continue;
+	    } // if
+	    for ( ; head != tail; head += 1 ) {
+		io_uring_cqe &cqe = r.cqes[head & *r.cqMask];
+		NBIOnode *p = (NBIOnode *)(uintptr_t)cqe.user_data;
+#ifdef __U_DEBUG_H__
+		uDebugPrt( "(uNBIO &)%p.uringReap, removing node %p, res:%d\n", this, p, cqe.res );
+#endif // __U_DEBUG_H__
+		pendingIOUring.remove( p );		// remove node from list of waiting tasks
+		p->nfds = cqe.res;			// set return value
+		p->pending.V();				// wake up waiting task (empty for IOPoller)
+		pending -= 1;
+#ifdef __U_STATISTICS__
+		uFetchAdd( Statistics::counters().uring_completions, 1 );
+#endif // __U_STATISTICS__
+	    } // for
+	    __atomic_store_n( r.cqHead, head, __ATOMIC_RELEASE ); // release entries to kernel
+	} // for
+    } // uNBIO::uringReap
+
+
+    bool uNBIO::initUring( NBIOnode &node, uIOUringOp &op ) {
+	IOUring &r = *ring;
+
+	if ( r.sqLocalTail - __atomic_load_n( r.sqHead, __ATOMIC_ACQUIRE ) == *r.sqEntries ) { // submission ring full ?
+	    uringSubmit();
+	    if ( r.sqLocalTail - __atomic_load_n( r.sqHead, __ATOMIC_ACQUIRE ) == *r.sqEntries ) {
+		node.nfds = -EAGAIN;			// caller performs the operation without io_uring
+		node.pending.V();
+		return false;
+	    } // if
+	} // if
+
+	unsigned int index = r.sqLocalTail & *r.sqMask;
+	io_uring_sqe &sqe = r.sqes[index];
+	memset( &sqe, 0, sizeof(sqe) );
+	switch ( op.opcode ) {
+	  case uIOUringOp::Read:    sqe.opcode = IORING_OP_READ;    break;
+	  case uIOUringOp::Readv:   sqe.opcode = IORING_OP_READV;   break;
+	  case uIOUringOp::Write:   sqe.opcode = IORING_OP_WRITE;   break;
+	  case uIOUringOp::Writev:  sqe.opcode = IORING_OP_WRITEV;  break;
+	  case uIOUringOp::Recv:    sqe.opcode = IORING_OP_RECV;    break;
+	  case uIOUringOp::Send:    sqe.opcode = IORING_OP_SEND;    break;
+	  case uIOUringOp::Recvmsg: sqe.opcode = IORING_OP_RECVMSG; break;
+	  case uIOUringOp::Sendmsg: sqe.opcode = IORING_OP_SENDMSG; break;
+	  case uIOUringOp::Accept:  sqe.opcode = IORING_OP_ACCEPT;  break;
+	  case uIOUringOp::Splice:  sqe.opcode = IORING_OP_SPLICE;  break;
+	} // switch
+	sqe.fd = op.fd;
+	sqe.len = op.len;
+	sqe.rw_flags = op.flags;			// union of per operation flags
+	if ( op.opcode == uIOUringOp::Splice ) {
+	    sqe.off = op.off;
+	    sqe.splice_fd_in = op.fdIn;
+	    sqe.splice_off_in = op.offIn;
+	} else {
+	    sqe.addr = (uintptr_t)op.addr;
+	    sqe.off = op.opcode == uIOUringOp::Accept ? (uintptr_t)op.addr2 : op.off;
+	} // if
+	sqe.user_data = (uintptr_t)&node;
+	r.sqArray[index] = index;
+	r.sqLocalTail += 1;
+	__atomic_store_n( r.sqTail, r.sqLocalTail, __ATOMIC_RELEASE ); // publish entry to kernel
+	ringUnsubmitted += 1;
+#ifdef __U_STATISTICS__
+	uFetchAdd( Statistics::counters().uring_submissions, 1 );
+#endif // __U_STATISTICS__
+
+#ifdef __U_DEBUG_H__
+	uDebugPrt( "(uNBIO &)%p.initUring, adding node %p for fd %d, opcode %d\n", this, &node, op.fd, op.opcode );
+#endif // __U_DEBUG_H__
+
+	pendingIOUring.addTail( &node );		// node is removed by IOPoller
+	pending += 1;
+
+	// Submissions are batched by the poller before it polls. If the poller is blocked, it cannot submit, so submit
+	// now and the completion wakes it through the ring fd. The fence pairs with the one in pollIO.
+	__sync_synchronize();
+	if ( IOPollerPid != (uPid_t)-1 ) uringSubmit();
+	return checkPoller();
+    } // uNBIO::initUring
+
+
+    int uNBIO::uring( uIOUringOp &op ) {
+	NBIOnode node;
+	node.pending.P();
+	node.nfds = 0;
+	node.pendingTask = &uThisTask();
+	node.fdType = NBIOnode::uringOp;
+	node.timedout = false;
+	node.nbioTimeout = &timeoutOccurred;
+
+	switch ( initUring( node, op ) ) {
+	  case false:					// not poller task ?
+	    node.pending.P();
+	    if ( ! node.listed() ) break;		// not poller task ?
+	    // FALL THROUGH
+	  case true:
+	    while ( pollIO( node ) ) uThisTask().uYieldNoPoll(); // busy wait
+	} // if
+
+#ifdef __U_DEBUG_H__
+	uDebugPrt( "(uNBIO &)%p.uring, exits, res:%d\n", this, node.nfds );
+#endif // __U_DEBUG_H__
+	return node.nfds;
+    } // uNBIO::uring
+#endif // __U_IOURING__
+
+
+    void uNBIO::selectCheckSfds() {
+	unsigned int i, tmasks;
+	NBIOnode *p;
+
+	tmasks = howmany( smaxFD, NFDBITS );		// total number of masks in fd set
+
+#ifdef __U_DEBUG_H__
+	uDebugAcquire();
+	uDebugPrt2( "(uNBIO &)%p.selectCheckSfds single set before smaxFD:%d\n", this, smaxFD );
+	printFDset( this, "srfds", tmasks, &srfds ); printFDset( this, "swfds", tmasks, &swfds ); printFDset( this, "sefds", tmasks, &sefds );
+	uDebugRelease();
+#endif // __U_DEBUG_H__
+
+	unsigned long int combined;
+	for ( i = 0; i < tmasks; i += 1 ) {		// single fds with no timeout
+	    // assumes the bits after the maxFD bit are unchanged by the OS when the mask is returned
+	    combined = mRFDs.fds_bits[i] | mWFDs.fds_bits[i];
+	    if ( efdsUsed )
+		combined |= mEFDs.fds_bits[i];
+
+	  if ( combined == 0 ) continue;		// no bits set in chunk ?
+
+	    srfds.fds_bits[i] &= ~mRFDs.fds_bits[i];
+	    swfds.fds_bits[i] &= ~mWFDs.fds_bits[i];
+	    if ( efdsUsed )
+		sefds.fds_bits[i] &= ~mEFDs.fds_bits[i];
+
+#ifdef __U_DEBUG_H__
+	    uDebugPrt( "(uNBIO &)%p.selectCheckSfds %d  combined:%lx  single %lx %lx %lx  master %lx %lx %lx \n",
+		       this, i, combined, srfds.fds_bits[i], swfds.fds_bits[i], sefds.fds_bits[i], mRFDs.fds_bits[i], mWFDs.fds_bits[i], mEFDs.fds_bits[i] );
+#endif // __U_DEBUG_H__
+
+	    // process each bit in the combined chunks
+	    for ( int fd = i * NFDBITS - 1; combined != 0; ) { // fd is origin 0 so substract 1
+#if ( defined( __linux__ ) || defined( __freebsd__ ) ) && __U_WORDSIZE__ == 64 // 64 bit architecture with ffsl
+		int posn = ffsl( combined );
+#elif __U_WORDSIZE__ == 32				// 32 bit architecture with ffs
+		int posn = ffs( combined );
+#else							// 64 bit architecture without ffsl
+		unsigned long int temp = combined & 0xffffffff; // extract least significant 32 bits
+		int posn = temp != 0 ? ffs( temp ) : ffs( combined >> 32 ) + 32;
+#endif // ffs
+		if ( posn == NFDBITS ) combined = 0; // shift of word size is nop
+		else combined >>= posn;
+		fd += posn;
+
+		// process each task waiting for this fd's events, list can be empty due to timeout
+		for ( uSeqIter<NBIOnode> iter( pendingIOSfds[fd] ); iter >> p; ) {
+		    checkSfds( fd, p, pendingIOSfds[fd] );
+		} // for
+	    } // for
+	} // for
+
+	smaxFD = findMaxFD( smaxFD, &srfds, &swfds,
+			    ! efdsUsed ? NULL :
+				&sefds );
+
+#ifdef __U_DEBUG_H__
+	tmasks = howmany( smaxFD, NFDBITS );		// total number of masks in fd set
+	uDebugAcquire();
+	uDebugPrt2( "(uNBIO &)%p.selectCheckSfds single set after smaxFD:%d\n", this, smaxFD );
+	printFDset( this, "srfds", tmasks, &srfds ); printFDset( this, "swfds", tmasks, &swfds ); printFDset( this, "sefds", tmasks, &sefds );
+	uDebugRelease();
+#endif // __U_DEBUG_H__
+    } // uNBIO::selectCheckSfds
+
+
     bool uNBIO::checkIOEnd( NBIOnode &node, int terrno ) {
 	unsigned int i, tcnt, cnt;
 	unsigned int tmasks;
@@ -423,11 +900,36 @@ namespace UPP {
 	uDebugPrt( "(uNBIO &)%p.checkIOEnd, select returns: found %d\n", this, descriptors );
 #endif // __U_DEBUG_H__
 
+#if defined( __U_IOURING__ )
+	if ( ring != NULL ) uringReap();		// completions can arrive without the ring fd being polled
+#endif // __U_IOURING__
+
 	if ( descriptors > 0 ) {			// I/O has occurred ?
 #ifdef __U_STATISTICS__
-	    uFetchAdd( Statistics::select_events, descriptors );
+	    uFetchAdd( Statistics::counters().select_events, descriptors );
 #endif // __U_STATISTICS__
 
+#if defined( __U_EPOLL__ )
+#if defined( __U_IOURING__ )
+	    for ( int i = 0; i < epollCnt; i += 1 ) {	// remove ring fd, its completions are already reaped
+		if ( epollEvents[i].data.fd == ringFD ) {
+		    epollCnt -= 1;
+		    epollEvents[i] = epollEvents[epollCnt];
+		    break;
+		} // if
+	    } // for
+#endif // __U_IOURING__
+	    for ( int i = 0; i < epollCnt; i += 1 ) {	// record events for each ready fd before checking tasks
+		EpollFd &efd = epollFds[epollEvents[i].data.fd];
+		unsigned int events = epollEvents[i].events;
+		efd.armed = 0;				// one-shot => fd is disarmed
+		// like select, hangup and error make a fd readable and writable
+		efd.ready = ( events & ( EPOLLIN | EPOLLHUP | EPOLLERR ) ? uCluster::ReadSelect : 0 ) |
+		    ( events & ( EPOLLOUT | EPOLLHUP | EPOLLERR ) ? uCluster::WriteSelect : 0 ) |
+		    ( events & EPOLLPRI ? uCluster::ExceptSelect : 0 );
+	    } // for
+#endif // __U_EPOLL__
+
 #ifdef __U_DEBUG_H__
 	    tmasks = howmany( maxFD, NFDBITS );		// total number of masks in fd set
 	    uDebugAcquire();
@@ -440,7 +942,7 @@ namespace UPP {
 	    for ( uSeqIter<NBIOnode> iter( pendingIOMfds ); iter >> p; ) { // multiple fds & single fds with timeout
 		if ( p->fdType == NBIOnode::singleFd ) { // single fd
 		    checkSfds( p->smfd.sfd.closure->access.fd, p, pendingIOMfds );
-		} else {				// multiple fds
+		} else if ( maxFD != 0 ) {		// multiple fds, unless only the epoll set was polled
 		    tcnt = 0;
 		    if ( ! multiples ) {		// only clear if there were some in the list
 			FD_ZERO( &mrfds );		// clear the read set
@@ -580,73 +1082,18 @@ namespace UPP {
 
 	    // Check to see which tasks are waiting for ready I/O operations and wake them.
 
-	    tmasks = howmany( smaxFD, NFDBITS );	// total number of masks in fd set
-
-#ifdef __U_DEBUG_H__
-	    uDebugAcquire();
-	    uDebugPrt2( "(uNBIO &)%p.checkIOEnd single set before smaxFD:%d\n", this, smaxFD );
-	    printFDset( this, "srfds", tmasks, &srfds ); printFDset( this, "swfds", tmasks, &swfds ); printFDset( this, "sefds", tmasks, &sefds );
-	    uDebugRelease();
-#endif // __U_DEBUG_H__
-
-	    unsigned long int combined;
-	    for ( i = 0; i < tmasks; i += 1 ) {		// single fds with no timeout
-		// assumes the bits after the maxFD bit are unchanged by the OS when the mask is returned
-		combined = mRFDs.fds_bits[i] | mWFDs.fds_bits[i];
-		if ( efdsUsed )
-		    combined |= mEFDs.fds_bits[i];
-
-	      if ( combined == 0 ) continue;		// no bits set in chunk ?
-
-		srfds.fds_bits[i] &= ~mRFDs.fds_bits[i];
-		swfds.fds_bits[i] &= ~mWFDs.fds_bits[i];
-		if ( efdsUsed )
-		    sefds.fds_bits[i] &= ~mEFDs.fds_bits[i];
-
-#ifdef __U_DEBUG_H__
-		uDebugPrt( "(uNBIO &)%p.checkIOEnd %d  combined:%lx  single %lx %lx %lx  master %lx %lx %lx \n",
-			   this, i, combined, srfds.fds_bits[i], swfds.fds_bits[i], sefds.fds_bits[i], mRFDs.fds_bits[i], mWFDs.fds_bits[i], mEFDs.fds_bits[i] );
-#endif // __U_DEBUG_H__
-
-		// process each bit in the combined chunks
-		for ( int fd = i * NFDBITS - 1; combined != 0; ) { // fd is origin 0 so substract 1
-#if ( defined( __linux__ ) || defined( __freebsd__ ) ) && __U_WORDSIZE__ == 64 // 64 bit architecture with ffsl
-		    int posn = ffsl( combined );
-#elif __U_WORDSIZE__ == 32				// 32 bit architecture with ffs
-		    int posn = ffs( combined );
-#else							// 64 bit architecture without ffsl
-		    unsigned long int temp = combined & 0xffffffff; // extract least significant 32 bits
-		    int posn = temp != 0 ? ffs( temp ) : ffs( combined >> 32 ) + 32;
-#endif // ffs
-		    if ( posn == NFDBITS ) combined = 0; // shift of word size is nop
-		    else combined >>= posn;
-		    fd += posn;
-
-		    // process each task waiting for this fd's events, list can be empty due to timeout
-		    for ( uSeqIter<NBIOnode> iter( pendingIOSfds[fd] ); iter >> p; ) {
-			checkSfds( fd, p, pendingIOSfds[fd] );
-		    } // for
-		} // for
-	    } // for
-
-	    smaxFD = findMaxFD( smaxFD, &srfds, &swfds,
-				! efdsUsed ? NULL :
-				    &sefds );
-
-#ifdef __U_DEBUG_H__
-	    tmasks = howmany( smaxFD, NFDBITS );	// total number of masks in fd set
-	    uDebugAcquire();
-	    uDebugPrt2( "(uNBIO &)%p.checkIOEnd single set after smaxFD:%d\n", this, smaxFD );
-	    printFDset( this, "srfds", tmasks, &srfds ); printFDset( this, "swfds", tmasks, &swfds ); printFDset( this, "sefds", tmasks, &sefds );
-	    uDebugRelease();
-#endif // __U_DEBUG_H__
-
+#if defined( __U_EPOLL__ )
+	    if ( epollFD != -1 ) {
+		epollCheckSfds();
+	    } else
+#endif // __U_EPOLL__
+		selectCheckSfds();
 	} else if ( descriptors == 0 ) {		// time limit expired, no IO is ready
 #ifdef __U_DEBUG_H__
 	    uDebugPrt( "(uNBIO &)%p.checkIOEnd, time limit expired\n", this );
 #endif // __U_DEBUG_H__
 #ifdef __U_STATISTICS__
-	    uFetchAdd( Statistics::select_nothing, 1 );
+	    uFetchAdd( Statistics::counters().select_nothing, 1 );
 #endif // __U_STATISTICS__
 
 	    if ( timeoutOccurred ) {			// non-polling timeout ?
@@ -672,7 +1119,7 @@ namespace UPP {
 	    uDebugPrt( "(uNBIO &)%p.checkIOEnd, error, errno:%d %s\n", this, terrno, strerror( terrno ) );
 #endif // __U_DEBUG_H__
 #ifdef __U_STATISTICS__
-	    uFetchAdd( Statistics::select_errors, 1 );
+	    uFetchAdd( Statistics::counters().select_errors, 1 );
 #endif // __U_STATISTICS__
 	    // Either an EINTR occurred or one of the clients specified a bad file number, and a EBADF was received.
 	    // This is handled by waking up all the clients, telling them that IO has occured so that they will retry
@@ -682,20 +1129,25 @@ namespace UPP {
 	    if ( terrno == EINTR ) {
 		// probably sigalrm from migrate, do nothing
 #ifdef __U_STATISTICS__
-		uFetchAdd( Statistics::select_eintr, 1 );
+		uFetchAdd( Statistics::counters().select_eintr, 1 );
 #endif // __U_STATISTICS__
 	    } else if ( terrno == EBADF ) {
 		// Received an unexpected error, chances are that one of the tasks has fouled up a call to some IO
 		// routine. Wake up all the tasks that were waiting for IO, allow them to retry their IO call and hope
 		// they catch the error this time.
 
-		for ( unsigned int fd = 0; fd < smaxFD; fd += 1 ) { // single fd with no timeout
-		    // process each task waiting for this fd's events, list can be empty due to timeout
-		    for ( uSeqIter<NBIOnode> iter( pendingIOSfds[fd] ); iter >> p; ) {
-			performIO( fd, p, pendingIOMfds, -1 );
+#if defined( __U_EPOLL__ )
+		if ( epollFD == -1 )			// single fds in epoll set are not part of the select
+#endif // __U_EPOLL__
+		{
+		    for ( unsigned int fd = 0; fd < smaxFD; fd += 1 ) { // single fd with no timeout
+			// process each task waiting for this fd's events, list can be empty due to timeout
+			for ( uSeqIter<NBIOnode> iter( pendingIOSfds[fd] ); iter >> p; ) {
+			    performIO( fd, p, pendingIOMfds, -1 );
+			} // for
 		    } // for
-		} // for
-		smaxFD = 0;
+		    smaxFD = 0;
+		} // if
 
 		bool multiples = false;
 		NBIOnode *p;
@@ -729,17 +1181,26 @@ namespace UPP {
 	if ( ! node.listed() ) {			// IOPoller's node removed ?
 	    if ( ! pendingIOMfds.empty() ) {		// any other tasks waiting for I/O event on a general FD mask?
 		unblockFD( pendingIOMfds );
+#if defined( __U_IOURING__ )
+	    } else if ( ! pendingIOUring.empty() ) {	// any other tasks waiting for an io_uring completion ?
+		unblockFD( pendingIOUring );
+#endif // __U_IOURING__
 	    } else {
-		if ( smaxFD == 0 || pendingIOSfds[smaxFD - 1].empty() ) {
+#if defined( __U_EPOLL__ )
+		if ( epollFD != -1 ) {			// find highest fd with waiting tasks
+		    for ( ; smaxFD != 0 && epollFds[smaxFD - 1].pendingIO.empty(); smaxFD -= 1 );
+		} // if
+#endif // __U_EPOLL__
+		if ( smaxFD == 0 || pendingIOSfd( smaxFD - 1 ).empty() ) {
 		    IOPoller = NULL;
 		} else {
-		    unblockFD( pendingIOSfds[smaxFD - 1] );
+		    unblockFD( pendingIOSfd( smaxFD - 1 ) );
 		} // if
 	    } // if
 	    return false;
 	} else {
 #ifdef __U_STATISTICS__
-	    uFetchAdd( Statistics::iopoller_spin, 1 );
+	    uFetchAdd( Statistics::counters().iopoller_spin, 1 );
 #endif // __U_STATISTICS__
 #ifdef __U_DEBUG_H__
 	    uDebugPrt( "(uNBIO &)%p.checkIOEnd, poller %.256s (%p) continuing to poll\n", this, uThisTask().getName(), &uThisTask() );
@@ -794,6 +1255,41 @@ namespace UPP {
     bool uNBIO::initSfd( NBIOnode &node, uEventNode *timeoutEvent ) {
 	unsigned int fd = node.smfd.sfd.closure->access.fd; // optimization
 
+#if defined( __U_EPOLL__ )
+	if ( epollFD != -1 ) {
+	    if ( fd >= epollFdsSize ) epollGrow( fd );	// increase fd table if necessary
+
+	    int terrno = epollArm( fd, epollFds[fd].armed | *node.smfd.sfd.uRWE );
+	    if ( terrno != 0 ) {			// fd cannot be waited on ?
+		// Perform the I/O now so the task receives the error, or the result for a fd that is always ready
+		// (EPERM, e.g., regular file), as select reports such fds ready immediately.
+		node.smfd.sfd.closure->wrapper();
+		node.nfds = terrno == EPERM ? countBits( *node.smfd.sfd.uRWE ) : -1;
+		node.pending.V();
+		return false;
+	    } // if
+
+	    if ( fd >= smaxFD ) {			// increase maxFD if necessary
+		smaxFD = fd + 1;
+	    } // if
+
+#ifdef __U_DEBUG_H__
+	    uDebugPrt( "(uNBIO &)%p.initSfd, adding node %p for fd %d to epoll set\n", this, &node, fd );
+#endif // __U_DEBUG_H__
+
+	    if ( timeoutEvent != NULL ) {
+		timeoutEvent->add();
+		pendingIOMfds.addTail( &node );		// node is removed by IOPoller
+	    } else {
+		epollFds[fd].pendingIO.addTail( &node );	// node is removed by IOPoller
+	    } // if
+
+	    // A poller blocked in the epoll set sees the new registration, so it is unnecessary to wake it.
+	    pending += 1;
+	    return checkPoller();
+	} // if
+#endif // __U_EPOLL__
+
 	if ( fd >= smaxFD ) {				// increase maxFD if necessary
 	    smaxFD = fd + 1;
 	} // if
@@ -885,9 +1381,45 @@ namespace UPP {
 #if ! defined( __U_MULTI__ )
 	okToSelect = false;
 #endif // ! __U_MULTI__
+#if defined( __U_EPOLL__ )
+	epollFds = NULL;				// fd table created on first use
+	epollFdsSize = 0;
+	epollCnt = 0;
+	epollFD = -1;
+	if ( uDefaultEpoll() ) {
+	    epollFD = ::epoll_create1( EPOLL_CLOEXEC );
+	    // epoll set must fit in the master read mask to be polled with multiple fds, otherwise use select
+	    if ( epollFD >= FD_SETSIZE ) {
+		::close( epollFD );
+		epollFD = -1;
+	    } // if
+	} // if
+#endif // __U_EPOLL__
+#if defined( __U_IOURING__ )
+	ring = NULL;					// rings created when a cluster enables io_uring
+	ringFD = -1;
+	ringUnsubmitted = 0;
+#endif // __U_IOURING__
     } // uNBIO::uNBIO
 
 
+    uNBIO::~uNBIO() {
+#if defined( __U_IOURING__ )
+	if ( ring != NULL ) {
+	    ::munmap( ring->sqes, ring->sqesSize );
+	    if ( ring->cqRing != ring->sqRing ) ::munmap( ring->cqRing, ring->cqRingSize );
+	    ::munmap( ring->sqRing, ring->sqRingSize );
+	    ::close( ringFD );
+	    delete ring;
+	} // if
+#endif // __U_IOURING__
+#if defined( __U_EPOLL__ )
+	if ( epollFD != -1 ) ::close( epollFD );
+	delete [] epollFds;
+#endif // __U_EPOLL__
+    } // uNBIO::~uNBIO
+
+
     int uNBIO::select( uIOClosure &closure, int &rwe, timeval *timeout ) {
 #ifdef __U_DEBUG_H__
 	uDebugAcquire();
@@ -897,7 +1429,11 @@ namespace UPP {
 	uDebugRelease();
 #endif // __U_DEBUG_H__
 
-	if ( closure.access.fd < 0 || FD_SETSIZE <= closure.access.fd ) {
+	if ( closure.access.fd < 0 || (
+#if defined( __U_EPOLL__ )
+		 epollFD == -1 &&			// epoll set has no fd limit
+#endif // __U_EPOLL__
+		 FD_SETSIZE <= closure.access.fd ) ) {
 	    uAbort( "Attempt to select on file descriptor %d that exceeds range 0-%d.",
 		    closure.access.fd, FD_SETSIZE - 1 );
 	} // if
@@ -48,13 +48,20 @@
 
 #include <limits.h>					// PTHREAD_STACK_MIN
 
-#include <sys/syscall.h>				// SYS_exit
+#include <sys/syscall.h>				// SYS_exit, SYS_futex
+#if defined( __U_PROCESSOR_FUTEX__ )
+#include <linux/futex.h>				// FUTEX_WAIT_PRIVATE, FUTEX_WAKE_PRIVATE
+#endif // __U_PROCESSOR_FUTEX__
 
 
 using namespace UPP;
 
 
+#if defined( __U_PROCESSOR_TIMER__ )
+uEventList *uProcessor::retiredEvents = NULL;
+#else
 uEventList *uProcessor::events = NULL;
+#endif // __U_PROCESSOR_TIMER__
 
 #if ! defined( __U_MULTI__ )
 uEventNode *uProcessor::contextEvent = NULL;
@@ -324,11 +331,18 @@ void *uKernelModule::startThread( void *p ) {
     // initialize thread members
 
     THREAD_SETMEM( activeProcessor, &processor );
+#ifdef __U_STATISTICS__
+    THREAD_SETMEM( statistics, &processor.statistics->counters );
+#endif // __U_STATISTICS__
     uCluster *currCluster = THREAD_GETMEM( activeProcessor )->currCluster;
     THREAD_SETMEM( activeCluster, currCluster );
     
     assert( THREAD_GETMEM( disableInt ) && THREAD_GETMEM( disableIntCnt ) == 1 );
 
+#if defined( __U_PROCESSOR_TIMER__ )
+    processor.events->createTimer( processor );		// timer must signal this kernel thread
+#endif // __U_PROCESSOR_TIMER__
+
     THREAD_GETMEM( This )->disableInterrupts();
     uMachContext::invokeCoroutine( *activeProcessorKernel );
 #endif // __U_MULTI__
@@ -351,6 +365,63 @@ inline void uProcessorKernel::taskIsBlocking() {
 } // uProcessorKernel::taskIsBlocking
 
 
+void uProcessorKernel::switchTask() {
+#if defined( __U_MULTI__ ) && ! defined( __U_SWAPCONTEXT__ )
+    // Fast path: the blocking task removes the next ready task and switches directly to it, rather than switching to the
+    // kernel coroutine, which then switches to the next task. The next task completes the schedule operation on behalf
+    // of the blocking task in switchComplete, after the blocking task's context is saved. The kernel is still entered
+    // on its first execution, for a terminating processor, a bound task or a pending roll forward, and when there is
+    // no task to switch to.
+
+    uBaseTask &task = uThisTask();			// optimization
+    uProcessor &processor = uThisProcessor();
+    if ( getState() != Start && ! processor.terminated && processor.external.empty() && &task.bound == NULL && ! THREAD_GETMEM( RFpending ) ) {
+	uCluster &cluster = *processor.currCluster;	// optimization
+	bool handoff = kind >= 2 && nextTask != &task && nextTask->currCluster == &cluster && &nextTask->bound == NULL;
+	uBaseTask *next = NULL;
+	if ( ! ( handoff && cluster.handoff ) && ! cluster.readyQueueEmpty() ) { // unlocked check, rechecked during removal
+	    next = &(cluster.readyQueueTryRemove());
+	} // if
+	if ( next == NULL && handoff ) {
+	    // Baton pass: no other task is ready or the cluster is in hand-off mode, so restart the task being woken
+	    // directly instead of putting it on the ready queue and removing it again.
+	    next = nextTask;
+	    next->setState( uBaseTask::Ready );
+	    kind -= 2;					// no wake
+#ifdef __U_STATISTICS__
+	    uFetchAdd( UPP::Statistics::counters().handoff_switches, 1 );
+#endif // __U_STATISTICS__
+	} // if
+	if ( next != NULL ) {				// task to schedule ?
+	    assert( ! next->readyRef.listed() && next != &task );
+	    direct = true;
+#ifdef __U_STATISTICS__
+	    uFetchAdd( UPP::Statistics::counters().user_context_switches, 1 );
+	    uFetchAdd( UPP::Statistics::counters().direct_switches, 1 );
+#endif // __U_STATISTICS__
+	    contextSw( next );				// not resume because switching to a task
+	    switchComplete();
+	    return;
+	} // if
+    } // if
+#endif // __U_MULTI__ && ! __U_SWAPCONTEXT__
+
+    contextSw();					// not resume because entering kernel
+    switchComplete();					// may be restarted directly by another task
+} // uProcessorKernel::switchTask
+
+
+void uProcessorKernel::switchComplete() {
+#ifdef __U_MULTI__
+    uProcessorKernel *kernel = activeProcessorKernel;	// task may restart on a different processor
+    if ( kernel->direct ) {				// previous task switched directly to this task ?
+	kernel->direct = false;
+	kernel->onBehalfOfUser();			// execute code on behalf of previous task
+    } // if
+#endif // __U_MULTI__
+} // uProcessorKernel::switchComplete
+
+
 void uProcessorKernel::scheduleInternal() {
     assert( ! uThisTask().readyRef.listed() );
     assert( ! THREAD_GETMEM( disableIntSpin ) );
@@ -358,7 +429,7 @@ void uProcessorKernel::scheduleInternal() {
     taskIsBlocking();
 
     kind = 0;
-    contextSw();					// not resume because entering kernel
+    switchTask();
 } // uProcessorKernel::scheduleInternal
 
 
@@ -370,7 +441,7 @@ void uProcessorKernel::scheduleInternal( uBaseSpinLock *lock ) {
 
     kind = 1;
     prevLock = lock;
-    contextSw();					// not resume because entering kernel
+    switchTask();
 } // uProcessorKernel::scheduleInternal
 
 
@@ -385,7 +456,7 @@ void uProcessorKernel::scheduleInternal( uBaseTask *task ) {
 
     kind = 2;
     nextTask = task;
-    contextSw();					// not resume because entering kernel
+    switchTask();
 } // uProcessorKernel::scheduleInternal
 
 
@@ -398,7 +469,7 @@ void uProcessorKernel::scheduleInternal( uBaseSpinLock *lock, uBaseTask *task )
     kind = 3;
     prevLock = lock;
     nextTask = task;
-    contextSw();					// not resume because entering kernel
+    switchTask();
 } // uProcessorKernel::scheduleInternal
 
 
@@ -480,7 +551,7 @@ void uProcessorKernel::setTimer( uDuration dur ) {
     it.it_interval.tv_sec = 0;				// not periodic
     it.it_interval.tv_XSEC = 0;
 #ifdef __U_STATISTICS__
-    uFetchAdd( Statistics::setitimer, 1 );
+    uFetchAdd( Statistics::counters().setitimer, 1 );
 #endif // __U_STATISTICS__
     setitimer( ITIMER_REAL, &it, NULL );		// set the alarm clock to go off
 } // uProcessorKernel::setTimer
@@ -635,7 +706,7 @@ void uProcessorKernel::main() {
 #endif // __U_MULTI__ && __U_SWAPCONTEXT__
 
 #ifdef __U_STATISTICS__
-	    uFetchAdd( UPP::Statistics::user_context_switches, 1 );
+	    uFetchAdd( UPP::Statistics::counters().user_context_switches, 1 );
 #endif // __U_STATISTICS__
 
 	    uSwitch( context, readyTask->currCoroutine->context );
@@ -724,7 +795,7 @@ void uProcessorKernel::main() {
 #endif // __U_MULTI__ && __U_SWAPCONTEXT__
 
 #ifdef __U_STATISTICS__
-	    uFetchAdd( UPP::Statistics::user_context_switches, 1 );
+	    uFetchAdd( UPP::Statistics::counters().user_context_switches, 1 );
 #endif // __U_STATISTICS__
 
 	    uSwitch( context, readyTask->currCoroutine->context );
@@ -786,16 +857,18 @@ void uProcessorKernel::main() {
 	if ( spin > processor->getSpin() ) {	// spin expired ?
 	    processor->currCluster->processorPause(); // put processor to sleep
 
+#if ! defined( __U_PROCESSOR_TIMER__ )
 	    if ( processor != uKernelModule::systemProcessor ) {
 		THREAD_SETMEM( RFpending, false );	// no pending roll forward
 	    } // if
+#endif // ! __U_PROCESSOR_TIMER__
 	    spin = 0;					// set number of spins back to zero
 	} // if
 
 // 	if ( spin % 200 == 0 ) {
 // 	    sched_yield();				// release CPU so someone else can execute
 // #ifdef __U_STATISTICS__
-// 	    uFetchAdd( Statistics::kernel_thread_yields, 1 );
+// 	    uFetchAdd( Statistics::counters().kernel_thread_yields, 1 );
 // #endif // __U_STATISTICS__
 // 	} // if
 
@@ -885,6 +958,10 @@ void uProcessorKernel::main() {
     // If available, wake another processor on this cluster, as this one is terminating.
     uThisCluster().makeProcessorActive();
 
+#if defined( __U_MULTI__ )
+    uHeapControl::finishThread();			// return kernel thread's cached storage to heap
+#endif // __U_MULTI__
+
 //#if defined( __U_MULTI__ )
 //    // Cannot call RealRtn::pthread_exit( NULL ) because it performs a handler cleanup that raises an exception on
 //    // Linux. The exception attempt to acquire a pthread_mutex_lock that calls a uOwnerLock, which cannot be called from
@@ -897,6 +974,9 @@ void uProcessorKernel::main() {
 
 
 uProcessorKernel::uProcessorKernel() : uBaseCoroutine( PTHREAD_STACK_MIN > __U_DEFAULT_STACK_SIZE__ ? PTHREAD_STACK_MIN : __U_DEFAULT_STACK_SIZE__ ) {
+#ifdef __U_MULTI__
+    direct = false;
+#endif // __U_MULTI__
 } // uProcessorKernel::uProcessorKernel
 
 uProcessorKernel::~uProcessorKernel() {
@@ -909,6 +989,42 @@ uProcessorKernel::~uProcessorKernel() {
 //######################### uProcessor #########################
 
 
+#if defined( __U_PROCESSOR_FUTEX__ )
+// Called by the processor's kernel thread after setting parkState to Parked and putting the processor on its cluster's
+// idle list. Signals remain unblocked, so a timer or time-slice signal sets parkState back to Active (see
+// uSigHandlerModule::sigAlrmHandler) and the futex wait either returns EINTR or does not block. Returns true if woken
+// while spinning.
+
+bool uProcessor::park() {
+    for ( unsigned int i = 0; i < ParkSpin; i += 1 ) {	// a waker often arrives shortly
+      if ( parkState != Parked ) return true;
+#if defined( __i386__ ) || defined( __x86_64__ )
+	asm volatile( "pause" );
+#endif // __i386__ || __x86_64__
+    } // for
+
+    if ( syscall( SYS_futex, &parkState, FUTEX_WAIT_PRIVATE, Parked, NULL, NULL, 0 ) == -1 &&
+	 errno != EAGAIN && errno != EINTR ) {
+	uAbort( "(uProcessor &)%p.park() : internal error, futex wait failed, error(%d) %s.", this, errno, strerror( errno ) );
+    } // if
+    parkState = Active;					// woken, interrupted, or spurious return
+    return false;
+} // uProcessor::park
+
+
+// Called by another kernel thread to wake this processor. Returns false if the processor is not parked, i.e., it is
+// already awake or it is Polling and must be signalled.
+
+bool uProcessor::unpark() {
+  if ( ! uCompareAssign( parkState, (int)Parked, (int)Active ) ) return false;
+    if ( syscall( SYS_futex, &parkState, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0 ) == -1 ) {
+	uAbort( "(uProcessor &)%p.unpark() : internal error, futex wake failed, error(%d) %s.", this, errno, strerror( errno ) );
+    } // if
+    return true;
+} // uProcessor::unpark
+#endif // __U_PROCESSOR_FUTEX__
+
+
 void uProcessor::createProcessor( uCluster &cluster, bool detached, int ms, int spin ) {
 #ifdef __U_DEBUG_H__
     uDebugPrt( "(uProcessor &)%p.createProcessor, on cluster %.256s (%p)\n", this, cluster.getName(), &cluster );
@@ -932,6 +1048,18 @@ void uProcessor::createProcessor( uCluster &cluster, bool detached, int ms, int
     preemption = ms;
     uProcessor::spin = spin;
 
+#if defined( __U_STATISTICS__ ) && defined( __U_MULTI__ )
+    statistics = Statistics::allocate();
+#endif // __U_STATISTICS__ && __U_MULTI__
+
+#if defined( __U_PROCESSOR_TIMER__ )
+    uKernelModule::globalProcessorLock->acquire();	// reuse event list of a deleted processor
+    events = retiredEvents;
+    if ( events != NULL ) retiredEvents = events->nextRetired;
+    uKernelModule::globalProcessorLock->release();
+    if ( events == NULL ) events = new uEventList;	// timer created when kernel thread starts
+#endif // __U_PROCESSOR_TIMER__
+
 #ifdef __U_MULTI__
     contextSwitchHandler = new uCxtSwtchHndlr( *this );
     contextEvent = new uEventNode( *contextSwitchHandler );
@@ -942,6 +1070,9 @@ void uProcessor::createProcessor( uCluster &cluster, bool detached, int ms, int
 #endif // __U_MULTI__
 
     terminated = false;
+#if defined( __U_PROCESSOR_FUTEX__ )
+    parkState = Active;
+#endif // __U_PROCESSOR_FUTEX__
     currCluster->processorAdd( *this );
 
     uKernelModule::globalProcessorLock->acquire();	// add processor to global processor list.
@@ -1063,11 +1194,34 @@ uProcessor::~uProcessor() {
 #ifdef __U_MULTI__
     delete contextEvent;
     delete contextSwitchHandler;
+#if defined( __U_PROCESSOR_TIMER__ )
+    if ( uKernelModule::systemTask == NULL ) {		// system processor at shutdown ?
+	timer_delete( events->timer );
+	delete events;
+	for ( uEventList *retired; ( retired = retiredEvents ) != NULL; ) {
+	    retiredEvents = retired->nextRetired;
+	    delete retired;
+	} // for
+    } else {
+	// Tasks may be waiting for events added by this processor, so the events move to the system processor. The list
+	// is kept for reuse rather than freed because a task may still be about to lock it (see uEventNode::remove).
+	events->retire( *uKernelModule::systemProcessor->events );
+	uKernelModule::globalProcessorLock->acquire();
+	events->nextRetired = retiredEvents;
+	retiredEvents = events;
+	uKernelModule::globalProcessorLock->release();
+    } // if
+#else
     if ( uKernelModule::systemTask == NULL ) {
 	delete events;
 	events = NULL;
     } // if
+#endif // __U_PROCESSOR_TIMER__
 #endif // __U_MULTI__
+
+#if defined( __U_STATISTICS__ ) && defined( __U_MULTI__ )
+    Statistics::release( statistics );			// counts remain in the totals
+#endif // __U_STATISTICS__ && __U_MULTI__
 } // uProcessor::~uProcessor
 
 
@@ -1079,7 +1233,7 @@ void uProcessor::fork( uProcessor *processor ) {
 
     int ret;
     pthread_attr_t attr;
-    // SIGALRM must only be caught by the system processor
+    // SIGALRM must only be caught by the system processor, unless each processor has its own timer
     sigset_t old_mask;
     if ( &uThisCluster() == uKernelModule::systemCluster ) {
 	// Child kernel-thread inherits the signal mask from the parent kernel-thread. So one special case for the
@@ -1089,7 +1243,9 @@ void uProcessor::fork( uProcessor *processor ) {
 	sigset_t new_mask;
 	sigemptyset( &new_mask );
 	sigemptyset( &old_mask );
+#if ! defined( __U_PROCESSOR_TIMER__ )
 	sigaddset( &new_mask, SIGALRM );
+#endif // ! __U_PROCESSOR_TIMER__
 #ifdef __U_PROFILER__
 	sigaddset( &new_mask, SIGVTALRM );
 #if defined( __U_HW_OVFL_SIG__ )
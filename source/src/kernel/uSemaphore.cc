@@ -73,7 +73,7 @@ namespace UPP {
 	if ( count < 0 ) {
 	    waiting.addTail( &(uThisTask().entryRef) );	// queue current task
 #ifdef __U_STATISTICS__
-	    uFetchAdd( UPP::Statistics::io_lock_queue, 1 );
+	    uFetchAdd( UPP::Statistics::counters().io_lock_queue, 1 );
 #endif // __U_STATISTICS__
 	    uProcessorKernel::schedule( &spinLock );	// atomically release spin lock and block
 	} else {
@@ -184,7 +184,7 @@ namespace UPP {
 	if ( count <= 0 ) {
 	    task = waiting.dropHead();			// remove task at head of waiting list
 #ifdef __U_STATISTICS__
-	    uFetchAdd( UPP::Statistics::io_lock_queue, -1 );
+	    uFetchAdd( UPP::Statistics::counters().io_lock_queue, -1 );
 #endif // __U_STATISTICS__
 	    spinLock.release();
 	    task->task().wake();			// make new owner
@@ -200,6 +200,7 @@ namespace UPP {
 	    uAbort( "Attempt to advance uSemaphore %p to %d that must be >= 0.", this, inc );
 	} // if
 #endif // __U_DEBUG__
+	uBaseTaskSeq released;				// tasks made new owners
 	spinLock.acquire();
 	for ( int i = inc; i > 0; i -= 1 ) {
 	    if ( count >= 0 ) {
@@ -207,9 +208,10 @@ namespace UPP {
 		break;
 	    } // if
 	    count += 1;
-	    waiting.dropHead()->task().wake();		// remove task at head of waiting list and make new owner
+	    released.addTail( &(waiting.dropHead()->task().readyRef) ); // remove task at head of waiting list
 	} // for
 	spinLock.release();
+	uBaseTask::wake( released );			// make new owners ready together
     } // uSemaphore::V
 } // UPP
 
@@ -183,10 +183,11 @@ namespace UPP {
 #endif // __U_DEBUG_H__
 
 #ifdef __U_STATISTICS__
+	// Only the handler counts signals in the kernel thread's block, so no atomic instruction is needed.
 	if ( sig == SIGUSR1 ) {
-	    uFetchAdd( UPP::Statistics::signal_usr1, 1 );
+	    Statistics::counters().signal_usr1 += 1;
 	} else if ( sig == SIGALRM ) {
-	    uFetchAdd( UPP::Statistics::signal_alarm, 1 );
+	    Statistics::counters().signal_alarm += 1;
 	} else {
 	    uAbort( "UNKNOWN ALARM SIGNAL\n" );
 	} // if
@@ -213,35 +214,46 @@ namespace UPP {
 	    errno = terrno;				// reset errno and continue
 #endif // __U_DEBUG_H__
 	    THREAD_SETMEM( RFpending, true );		// indicate roll forward is required
+#if defined( __U_PROCESSOR_FUTEX__ )
+	    // A processor parking in uCluster::processorPause must not block in the futex wait.
+	    uProcessor *processor = THREAD_GETMEM( activeProcessor );
+	    if ( processor != NULL && processor->parkState == uProcessor::Parked ) {
+		processor->parkState = uProcessor::Active;
+	    } // if
+#endif // __U_PROCESSOR_FUTEX__
 	    return;
 	} // if
 
 	// Unsafe to perform these checks if in kernel or performing roll forward, because the thread specific variables
 	// used by uThis* routines are changing.
-#if defined( __U_DEBUG__ ) && defined( __U_MULTI__ )
+#if defined( __U_DEBUG__ ) && defined( __U_MULTI__ ) && ! defined( __U_PROCESSOR_TIMER__ )
 	if ( sig == SIGALRM ) {				// only handle SIGALRM on system cluster
 	    assert( &uThisProcessor() == uKernelModule::systemProcessor );
 	    assert( &uThisCluster() == uKernelModule::systemCluster );
 	} // if
-#endif // __U_DEBUG__ && __U_MULTI__
+#endif // __U_DEBUG__ && __U_MULTI__ && ! __U_PROCESSOR_TIMER__
 #if defined( __U_DEBUG__ )
 	uThisCoroutine().verify();			// good place to check for stack overflow
 #endif // __U_DEBUG__
 
-#if defined( __U_MULTI__ )
+#if defined( __U_MULTI__ ) && ! defined( __U_PROCESSOR_TIMER__ )
 	if ( &uThisProcessor() != uKernelModule::systemProcessor ) {
 	    THREAD_SETMEM( RFinprogress, true );	// starting roll forward
 	} // if
-#endif // __U_MULTI__
+#endif // __U_MULTI__ && ! __U_PROCESSOR_TIMER__
 
 	// Clear blocked SIGALRM/SIGUSR1 so more can arrive.
 	if ( sizeof( sigset_t ) != sizeof( cxt->uc_sigmask ) ) { // should disappear due to constant folding
 	    // uc_sigmask is incorrect size
 	    sigset_t new_mask;
 	    sigemptyset( &new_mask );
+#if defined( __U_PROCESSOR_TIMER__ )
+	    sigaddset( &new_mask, SIGALRM );		// every processor has a timer
+#else
 	    if ( &uThisProcessor() == uKernelModule::systemProcessor ) {
 		sigaddset( &new_mask, SIGALRM );
 	    } // if
+#endif // __U_PROCESSOR_TIMER__
 	    sigaddset( &new_mask, SIGUSR1 );
 	    if ( sigprocmask( SIG_UNBLOCK, &new_mask, NULL ) == -1 ) {
 		uAbort( "internal error, sigprocmask" );
@@ -29,7 +29,6 @@
 #define __U_KERNEL__
 #include <uC++.h>
 #include <uSystemTask.h>
-#include <uSequence.h>
 #include <csignal>					// access: sigset_t
 #include <cerrno>					// access: EBUSY, ETIMEDOUT
 #include <cstdlib>					// access: exit
@@ -48,22 +47,33 @@
 #define NOT_A_PTHREAD ((pthread_t)-2)			// used as return from pthread_self for non-pthread tasks
 
 namespace UPP {
-    struct Pthread_values : public uSeqable {		// thread specific data
-	bool in_use;
+    // A key is in use when its sequence number is odd; creating and deleting a key each advance the sequence number, so
+    // a value stored by a task is valid only while its recorded sequence number matches the key's. Hence, deleting a key
+    // implicitly invalidates every task's value without touching the tasks.
+
+    struct Pthread_values {				// thread specific data
+	unsigned int sequence;				// key sequence number when value set
 	void *value;
     }; // Pthread_values
 
     struct Pthread_keys {				// all of these fields are initialized with zero
-	bool in_use;
+	volatile unsigned int sequence;			// odd => in use
 	void (*destructor)( void * );
-	uSequence<Pthread_values> threads;
     }; // Pthread_keys
 
+    // Per-task values are allocated lazily in small chunks of keys, so a task using a few keys does not pay for
+    // PTHREAD_KEYS_MAX values.
+
+    enum { PthreadValuesChunk = 32, PthreadValuesChunks = (PTHREAD_KEYS_MAX + PthreadValuesChunk - 1) / PthreadValuesChunk };
+
+    struct Pthread_specific {				// task specific data, pointed to by uBaseTask::pthreadData
+	Pthread_values *chunks[PthreadValuesChunks];
+    }; // Pthread_specific
+
     // Create storage separately to ensure no constructors are called.
     char u_pthread_keys_storage[sizeof(Pthread_keys) * PTHREAD_KEYS_MAX] __attribute__((aligned (16))) = {0};
 #   define u_pthread_keys ((Pthread_keys *)u_pthread_keys_storage)
 
-    static pthread_mutex_t u_pthread_keys_lock = PTHREAD_MUTEX_INITIALIZER;
     static pthread_mutex_t u_pthread_once_lock = PTHREAD_MUTEX_INITIALIZER;
 
     struct Pthread_kernel_threads : public uColable {
@@ -786,8 +796,7 @@ extern "C" {
 
 
     void pthread_deletespecific_( void *pthreadData ) __THROW { // see uMachContext::invokeTask
-	pthread_mutex_lock( &u_pthread_keys_lock );
-	Pthread_values *values = (Pthread_values *)pthreadData;
+	Pthread_specific *specific = (Pthread_specific *)pthreadData;
 
 	// If, after all the destructors have been called for all non-NULL values with associated destructors, there are
 	// still some non-NULL values with associated destructors, then the process is repeated. If, after at least
@@ -799,38 +808,41 @@ extern "C" {
 	bool destcalled = true;
 	for ( int attempts = 0; attempts < PTHREAD_DESTRUCTOR_ITERATIONS && destcalled ; attempts += 1 ) {
 	    destcalled = false;
-	    for ( int i = 0; i < PTHREAD_KEYS_MAX; i += 1 ) { // remove each value from key list
+	    for ( int c = 0; c < PthreadValuesChunks; c += 1 ) { // only allocated chunks can hold values
+		Pthread_values *values = specific->chunks[c];
+	      if ( values == NULL ) continue;
+		for ( int i = 0; i < PthreadValuesChunk; i += 1 ) {
+		    Pthread_values &entry = values[i];
+		    Pthread_keys &key = u_pthread_keys[c * PthreadValuesChunk + i];
+		    if ( entry.value != NULL && entry.sequence == key.sequence ) { // value for a live key ?
 #ifdef __U_DEBUG_H__
-		if ( values[i].in_use ) {
-		    uDebugPrt( "pthread_deletespecific_, value[%d].in_use:%d, value:%p\n",
-			       i, values[i].in_use, values[i].value );
-		} // if
+			uDebugPrt( "pthread_deletespecific_, value[%d].sequence:%u, value:%p\n",
+				   c * PthreadValuesChunk + i, entry.sequence, entry.value );
 #endif // __U_DEBUG_H__
-		if ( values[i].in_use ) {
-		    Pthread_values &entry = values[i];
-		    entry.in_use = false;
-		    u_pthread_keys[i].threads.remove( &entry );
-		    if ( u_pthread_keys[i].destructor != NULL && entry.value != NULL ) {
 			void *data = entry.value;
 			entry.value = NULL;
+			void (*destructor)( void * ) = key.destructor;
+			if ( destructor != NULL ) {
 #ifdef __U_DEBUG_H__
-			uDebugPrt( "pthread_deletespecific_, task:%p, destructor:%p, value:%p begin\n",
-				   &uThisTask(), u_pthread_keys[i].destructor, data );
+			    uDebugPrt( "pthread_deletespecific_, task:%p, destructor:%p, value:%p begin\n",
+				       &uThisTask(), destructor, data );
 #endif // __U_DEBUG_H__
-			destcalled = true;
-			pthread_mutex_unlock( &u_pthread_keys_lock );
-			u_pthread_keys[i].destructor( data );
-			pthread_mutex_lock( &u_pthread_keys_lock );
+			    destcalled = true;
+			    destructor( data );
 #ifdef __U_DEBUG_H__
-			uDebugPrt( "pthread_deletespecific_, task:%p, destructor:%p, value:%p end\n",
-				   &uThisTask(), u_pthread_keys[i].destructor, data );
+			    uDebugPrt( "pthread_deletespecific_, task:%p, destructor:%p, value:%p end\n",
+				       &uThisTask(), destructor, data );
 #endif // __U_DEBUG_H__
+			} // if
 		    } // if
-		} // if
+		} // for
 	    } // for
 	} // for
-	pthread_mutex_unlock( &u_pthread_keys_lock );
-	delete [] values;
+
+	for ( int c = 0; c < PthreadValuesChunks; c += 1 ) {
+	    delete [] specific->chunks[c];
+	} // for
+	delete specific;
     } // pthread_deletespecific_
 
 
@@ -838,12 +850,12 @@ extern "C" {
 #ifdef __U_DEBUG_H__
 	uDebugPrt( "pthread_key_create(key:%p, destructor:%p) enter task:%p\n", key, destructor, &uThisTask() );
 #endif // __U_DEBUG_H__
-	pthread_mutex_lock( &u_pthread_keys_lock );
 	for ( int i = 0; i < PTHREAD_KEYS_MAX; i += 1 ) {
- 	    if ( ! u_pthread_keys[i].in_use ) {
-		u_pthread_keys[i].in_use = true;
+	    unsigned int sequence = u_pthread_keys[i].sequence;
+ 	    if ( (sequence & 1) == 0 && uCompareAssign( u_pthread_keys[i].sequence, sequence, sequence + 1 ) ) { // claim free key ?
+		// No task can have a value for the new sequence number until the key is returned, so the destructor can be
+		// set after the key is claimed.
 		u_pthread_keys[i].destructor = destructor;
-		pthread_mutex_unlock( &u_pthread_keys_lock );
 		*key = i;
 #ifdef __U_DEBUG_H__
 		uDebugPrt( "pthread_key_create(key:%d, destructor:%p) exit task:%p\n", *key, destructor, &uThisTask() );
@@ -851,7 +863,6 @@ extern "C" {
 		return 0;
 	    } // if
 	} // for
-	pthread_mutex_unlock( &u_pthread_keys_lock );
 #ifdef __U_DEBUG_H__
 	uDebugPrt( "pthread_key_create(key:%p, destructor:%p) try again!!! task:%p\n", key, destructor, &uThisTask() );
 #endif // __U_DEBUG_H__
@@ -862,24 +873,10 @@ extern "C" {
 #ifdef __U_DEBUG_H__
 	uDebugPrt( "pthread_key_delete(key:0x%x) enter task:%p\n", key, &uThisTask() );
 #endif // __U_DEBUG_H__
-	pthread_mutex_lock( &u_pthread_keys_lock );
-      if ( key >= PTHREAD_KEYS_MAX || ! u_pthread_keys[key].in_use ) {
-	    pthread_mutex_unlock( &u_pthread_keys_lock );
-	    return EINVAL;
-	} // if
-	u_pthread_keys[key].in_use = false;
-	u_pthread_keys[key].destructor = NULL;
-
-	// Remove key from all threads with a value.
-
-	Pthread_values *p;
-	uSequence<Pthread_values> &head = u_pthread_keys[key].threads;
-	for ( uSeqIter<Pthread_values> iter( head ); iter >> p; ) {
-	    p->in_use = false;
-	    head.remove( p );
-	} // for
-
-	pthread_mutex_unlock( &u_pthread_keys_lock );
+      if ( key >= PTHREAD_KEYS_MAX ) return EINVAL;
+	unsigned int sequence = u_pthread_keys[key].sequence;
+	// Advancing the sequence number invalidates the key's value in all tasks, so no task list is walked.
+      if ( (sequence & 1) == 0 || ! uCompareAssign( u_pthread_keys[key].sequence, sequence, sequence + 1 ) ) return EINVAL;
 #ifdef __U_DEBUG_H__
 	uDebugPrt( "pthread_key_delete(key:0x%x) exit task:%p\n", key, &uThisTask() );
 #endif // __U_DEBUG_H__
@@ -890,32 +887,33 @@ extern "C" {
 #ifdef __U_DEBUG_H__
 	uDebugPrt( "pthread_setspecific(key:0x%x, value:%p) enter task:%p\n", key, value, &uThisTask() );
 #endif // __U_DEBUG_H__
-	uBaseTask &t = uThisTask();
+      if ( key >= PTHREAD_KEYS_MAX ) return EINVAL;
+	unsigned int sequence = u_pthread_keys[key].sequence;
+      if ( (sequence & 1) == 0 ) return EINVAL;		// key not in use ?
 
-	Pthread_values *values;
-	if ( t.pthreadData == NULL ) {
-	    values = new Pthread_values[PTHREAD_KEYS_MAX];
-	    t.pthreadData = values;
-	    for ( int i = 0; i < PTHREAD_KEYS_MAX; i += 1 ) {
-		values[i].in_use = false;
+	// Only the owning task accesses its values, so no locking is necessary.
+	uBaseTask &t = uThisTask();
+	Pthread_specific *specific = (Pthread_specific *)t.pthreadData;
+	if ( specific == NULL ) {
+	    specific = new Pthread_specific;
+	    for ( int c = 0; c < PthreadValuesChunks; c += 1 ) {
+		specific->chunks[c] = NULL;
 	    } // for
-	} else {
-	    values = (Pthread_values *)t.pthreadData;
+	    t.pthreadData = specific;
 	} // if
 
-	pthread_mutex_lock( &u_pthread_keys_lock );
-      if ( key >= PTHREAD_KEYS_MAX || ! u_pthread_keys[key].in_use ) {
-	    pthread_mutex_unlock( &u_pthread_keys_lock );
-	    return EINVAL;
+	Pthread_values *&values = specific->chunks[key / PthreadValuesChunk];
+	if ( values == NULL ) {
+	    values = new Pthread_values[PthreadValuesChunk];
+	    for ( int i = 0; i < PthreadValuesChunk; i += 1 ) {
+		values[i].sequence = 0;			// never matches an in-use key
+		values[i].value = NULL;
+	    } // for
 	} // if
 
-	Pthread_values &entry = values[key];
-	if ( ! entry.in_use ) {
-	    entry.in_use = true;
-	    u_pthread_keys[key].threads.add( &entry );
-	} // if
+	Pthread_values &entry = values[key % PthreadValuesChunk];
+	entry.sequence = sequence;
 	entry.value = (void *)value;
-	pthread_mutex_unlock( &u_pthread_keys_lock );
 #ifdef __U_DEBUG_H__
 	uDebugPrt( "pthread_setspecific(key:0x%x, value:%p) exit task:%p\n", key, value, &uThisTask() );
 #endif // __U_DEBUG_H__
@@ -928,17 +926,14 @@ extern "C" {
 #endif // __U_DEBUG_H__
       if ( key >= PTHREAD_KEYS_MAX ) return NULL;
 
-	uBaseTask &t = uThisTask();
-      if ( t.pthreadData == NULL ) return NULL;
+	Pthread_specific *specific = (Pthread_specific *)uThisTask().pthreadData;
+      if ( specific == NULL ) return NULL;
+	Pthread_values *values = specific->chunks[key / PthreadValuesChunk];
+      if ( values == NULL ) return NULL;
 
-	pthread_mutex_lock( &u_pthread_keys_lock );
-	Pthread_values &entry = ((Pthread_values *)t.pthreadData)[key];
-      if ( ! entry.in_use ) {
-	    pthread_mutex_unlock( &u_pthread_keys_lock );
-	    return NULL;
-	} // if
+	Pthread_values &entry = values[key % PthreadValuesChunk];
+      if ( entry.sequence != u_pthread_keys[key].sequence ) return NULL; // key deleted or recreated since value set ?
 	void *value = entry.value;
-	pthread_mutex_unlock( &u_pthread_keys_lock );
 #ifdef __U_DEBUG_H__
 	uDebugPrt( "%p = pthread_getspecific(key:0x%x) exit task:%p\n", value, key, &uThisTask() );
 #endif // __U_DEBUG_H__
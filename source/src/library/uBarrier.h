@@ -32,13 +32,65 @@
 
 
 _Mutex _Coroutine uBarrier {
-    uCondition Waiters;
-    unsigned int Total, Count;
+    // Tasks arrive at the nodes of a combining tree, fanin tasks or child nodes per node, so arrivals contend only on
+    // their node. The last arrival at a node moves up to its parent, and the last arrival at the root completes the
+    // barrier. The flat barrier is a tree with a single node. Each node has a gate for each of two alternating episodes,
+    // so a task released from one episode cannot take the wakeup of a slow task that has not yet blocked in that
+    // episode. On completion, each task that moved up a node releases all the waiters at that node with one
+    // semaphore V, which makes them ready together.
+
+    struct Node {
+	unsigned int size;				// arrivals that complete this node
+	volatile unsigned int count;			// arrivals so far in this episode
+	Node *parent;					// NULL => root
+	UPP::uSemaphore gate0, gate1;			// waiters for even and odd episodes
+
+	Node() : count( 0 ), parent( NULL ), gate0( 0 ), gate1( 0 ) {}
+
+	UPP::uSemaphore &gate( bool episode ) {
+	    return episode ? gate1 : gate0;
+	} // Node::gate
+    }; // Node
+
+    unsigned int Total, Fanin;				// Fanin == 0 => flat
+    unsigned int degree;				// tasks or child nodes per node
+    volatile unsigned int Count;			// arrivals so far in this episode
+    volatile bool episode;				// alternates on each completion
+    Node *nodes;					// leaves first, root last
 
     void init( unsigned int total ) {
 	Count = 0;
 	Total = total;
+	degree = Fanin < 2 || Fanin >= total ? ( total == 0 ? 1 : total ) : Fanin;
+
+	unsigned int size = 0;
+	for ( unsigned int width = total; ; ) {		// width is the number of arrivals at a level
+	    unsigned int n = width == 0 ? 1 : ( width + degree - 1 ) / degree;
+	    size += n;
+	  if ( n == 1 ) break;
+	    width = n;
+	} // for
+	delete [] nodes;
+	nodes = new Node[size];
+
+	Node *level = nodes;				// first node of current level
+	for ( unsigned int width = total; ; ) {
+	    unsigned int n = width == 0 ? 1 : ( width + degree - 1 ) / degree;
+	    for ( unsigned int i = 0; i < n; i += 1 ) {
+		level[i].size = i < n - 1 ? degree : width - i * degree;
+		if ( n != 1 ) level[i].parent = &level[n + i / degree];
+	    } // for
+	  if ( n == 1 ) break;
+	    level += n;
+	    width = n;
+	} // for
     } // uBarrier::init
+
+    _Mutex void complete() {				// last arrival at the root
+	last();						// call the last routine
+	Count = 0;					// reset for next episode
+	episode = ! episode;
+    } // uBarrier::complete
   protected:
     void main() {
 	for ( ;; ) {
@@ -46,11 +98,16 @@ _Mutex _Coroutine uBarrier {
 	} // for
     } // uBarrier::main
   public:
-    uBarrier( unsigned int total ) {
+    uBarrier( unsigned int total ) : Fanin( 0 ), episode( false ), nodes( NULL ) {
+	init( total );
+    } // uBarrier::uBarrier
+
+    uBarrier( unsigned int total, unsigned int fanin ) : Fanin( fanin ), episode( false ), nodes( NULL ) {
 	init( total );
     } // uBarrier::uBarrier
 
     virtual ~uBarrier() {
+	delete [] nodes;
     } // uBarrier::~uBarrier
 
     _Nomutex unsigned int total() const {		// total participants in the barrier
@@ -70,18 +127,30 @@ _Mutex _Coroutine uBarrier {
 	init( total );
     } // uBarrier::reset
 
-    virtual void block() {
-	Count += 1;
-	if ( Count < Total ) {				// all tasks arrived ?
-	    Waiters.wait();
-	} else {
-	    last();					// call the last routine
-	    for ( ; ! Waiters.empty(); ) {		// restart all waiting tasks
-		Waiters.signal();			// LIFO release, N-1 cxt switches
-//		Waiters.signalBlock();			// FIFO release, 2N cxt switches
-	    } // for
+    _Nomutex virtual void block() {
+	bool parity = episode;				// read before arriving, flipped only after all tasks arrive
+	unsigned int ticket = uFetchAdd( Count, 1 );
+#ifdef __U_DEBUG__
+	if ( ticket >= Total && Total != 0 ) {
+	    uAbort( "(uBarrier &)%p.block() : Attempt by more than %d tasks to block on barrier before it completes.", this, Total );
 	} // if
-	Count -= 1;
+#endif // __U_DEBUG__
+	Node *leaf = &nodes[ticket < Total ? ticket / degree : 0], *node;
+	for ( node = leaf; ; node = node->parent ) {	// move up while last arrival at node
+	    if ( uFetchAdd( node->count, 1 ) + 1 < node->size ) {
+		node->gate( parity ).P();		// wait for completion
+		break;
+	    } // if
+	    node->count = 0;				// reset for next episode
+	    if ( node->parent == NULL ) {		// root ?
+		complete();
+		node = NULL;
+		break;
+	    } // if
+	} // for
+	for ( Node *n = leaf; n != node; n = n->parent ) { // release waiters at nodes completed by this task
+	    if ( n->size > 1 ) n->gate( parity ).V( n->size - 1 );
+	} // for
     } // uBarrier::block
 
     virtual void last() {				// called by last task to reach the barrier
@@ -33,6 +33,9 @@
 
 #include <functional>
 #include <memory>
+#include <vector>
+#include <algorithm>					// access: min, max
+#include <type_traits>					// access: common_type
 
 #pragma __U_NOT_USER_CODE__
 
@@ -63,30 +66,164 @@ void uCobegin( std::initializer_list< std::function< void( unsigned int ) >> fun
     delete [] runners;
 } // uCobegin
 
+// Parallel for
+
+// The iteration range [low, high) is split into grain-sized chunks, which are run by a fixed set of workers, one per
+// processor of the current cluster, where the calling task is worker 0. Each worker starts with a contiguous block of
+// chunks, takes chunks from the front of its block, and when its block is empty, steals the back half of the remaining
+// chunks of another worker.
+
+namespace UPP {
+    class uParallelForEngine {
+	typedef std::function<void ( size_t, size_t, unsigned int )> Chunk; // [low, high) offsets, worker id
+
+	struct Range {					// chunks of a worker
+	    uSpinLock lock;
+	    size_t next, end;				// [next, end)
+	    char padding[64];				// reduce false sharing among workers
+	}; // Range
+
+	_Task Worker {
+	    uParallelForEngine &engine;
+	    unsigned int id;
+
+	    void main() { engine.work( id ); }
+	  public:
+	    Worker( uParallelForEngine &engine, unsigned int id ) : engine( engine ), id( id ) {}
+	}; // Worker
+
+	const size_t size, grain;
+	unsigned int workers;
+	Range *ranges;
+	Chunk chunk;
+
+	bool steal( unsigned int id, size_t &c ) {
+	    for ( unsigned int i = 1; i < workers; i += 1 ) {
+		Range &victim = ranges[(id + i) % workers];
+		victim.lock.acquire();
+		size_t remaining = victim.end - victim.next;
+		if ( remaining != 0 ) {
+		    size_t half = (remaining + 1) / 2;
+		    size_t end = victim.end;
+		    victim.end -= half;
+		    victim.lock.release();
+		    c = end - half;			// run first stolen chunk, keep rest
+		    Range &mine = ranges[id];
+		    mine.lock.acquire();
+		    mine.next = c + 1;
+		    mine.end = end;
+		    mine.lock.release();
+		    return true;
+		} // if
+		victim.lock.release();
+	    } // for
+	    return false;				// no work anywhere
+	} // uParallelForEngine::steal
+
+	bool take( unsigned int id, size_t &c ) {
+	    Range &mine = ranges[id];
+	    mine.lock.acquire();
+	    if ( mine.next != mine.end ) {
+		c = mine.next;
+		mine.next += 1;
+		mine.lock.release();
+		return true;
+	    } // if
+	    mine.lock.release();
+	    return steal( id, c );
+	} // uParallelForEngine::take
+
+	void work( unsigned int id ) {
+	    for ( size_t c; take( id, c ); ) {
+		size_t low = c * grain;
+		chunk( low, std::min( low + grain, size ), id );
+	    } // for
+	} // uParallelForEngine::work
+      public:
+	static unsigned int processors() {
+	    return uThisCluster().getProcessors();
+	} // uParallelForEngine::processors
+
+	uParallelForEngine( size_t size, size_t grain, unsigned int workers, Chunk chunk ) :
+		size( size ), grain( grain != 0 ? grain : std::max( size / (workers * 8), (size_t)1 ) ), workers( workers ), chunk( chunk ) {
+	    size_t chunks = (size + this->grain - 1) / this->grain;
+	    if ( chunks < this->workers ) this->workers = chunks; // no idle workers
+	    ranges = new Range[this->workers];
+	    for ( unsigned int w = 0; w < this->workers; w += 1 ) { // contiguous block of chunks per worker
+		ranges[w].next = chunks * w / this->workers;
+		ranges[w].end = chunks * (w + 1) / this->workers;
+	    } // for
+	} // uParallelForEngine::uParallelForEngine
+
+	~uParallelForEngine() {
+	    delete [] ranges;
+	} // uParallelForEngine::~uParallelForEngine
+
+	unsigned int getWorkers() const {
+	    return workers;
+	} // uParallelForEngine::getWorkers
+
+	void run() {
+	    if ( workers == 0 ) return;			// empty range
+	    Worker **others = new Worker *[workers - 1]; // do not use up task stack
+	    for ( unsigned int w = 1; w < workers; w += 1 ) others[w - 1] = new Worker( *this, w );
+	    work( 0 );					// calling task is worker 0
+	    for ( unsigned int w = 1; w < workers; w += 1 ) delete others[w - 1];
+	    delete [] others;
+	} // uParallelForEngine::run
+    }; // uParallelForEngine
+} // UPP
+
+// Call body( lo, hi ) for each chunk [lo, hi) of [low, high). A grain of 0 selects about 8 chunks per worker.
+
+template<typename Low, typename High, typename Body>
+void uParallelForRange( Low low, High high, Body body, size_t grain = 0 ) {
+    typedef typename std::common_type<Low, High>::type Index;
+    assert( low <= high );
+    UPP::uParallelForEngine engine( (Index)high - (Index)low, grain, UPP::uParallelForEngine::processors(),
+				    [&]( size_t lo, size_t hi, unsigned int ) { body( (Index)(low + lo), (Index)(low + hi) ); } );
+    engine.run();
+} // uParallelForRange
+
+// Call body( i ) for each i in [low, high).
+
+template<typename Low, typename High, typename Body>
+void uParallelFor( Low low, High high, Body body, size_t grain = 0 ) {
+    typedef typename std::common_type<Low, High>::type Index;
+    uParallelForRange( low, high, [&]( Index lo, Index hi ) { for ( Index i = lo; i < hi; i += 1 ) body( i ); }, grain );
+} // uParallelFor
+
+// Return combine over map( i ) for each i in [low, high), starting from identity. Each worker combines its own
+// iterations, and the worker results are then combined, so combine must be associative and commutative.
+
+template<typename Low, typename High, typename T, typename Map, typename Combine>
+T uParallelReduce( Low low, High high, T identity, Map map, Combine combine, size_t grain = 0 ) {
+    typedef typename std::common_type<Low, High>::type Index;
+    assert( low <= high );
+    unsigned int workers = UPP::uParallelForEngine::processors();
+    std::vector<T> partials( workers, identity );	// one accumulator per worker
+    UPP::uParallelForEngine engine( (Index)high - (Index)low, grain, workers,
+				    [&]( size_t lo, size_t hi, unsigned int id ) {
+					T &partial = partials[id];
+					for ( Index i = low + lo; i < (Index)(low + hi); i += 1 ) partial = combine( partial, map( i ) );
+				    } );
+    engine.run();
+    T result = identity;
+    for ( unsigned int w = 0; w < engine.getWorkers(); w += 1 ) result = combine( result, partials[w] );
+    return result;
+} // uParallelReduce
+
 // COFOR
 
+// Iterations are run by the parallel-for workers rather than a task per iteration, so an iteration must not wait for
+// another iteration of the same COFOR.
+
 #define COFOR( lidname, low, high, body ) uCofor( low, high, [&]( unsigned int lidname ){ body } );
 
 template<typename Low, typename High>			// allow bounds to have different types (needed for constants)
 void uCofor( Low low, High high, std::function<void ( unsigned int )> f ) {
-    unsigned int lid = 0;
-    _Task Runner {
-	typedef std::function<void( unsigned int )> Func; // function type
-	unsigned int parm;				// local thread lid
-	Func f;						// function to run for each lid
-
-	void main() { f( parm ); }
-      public:
-	Runner( unsigned int parm, Func f ) : parm( parm ), f( f ) {}
-    }; // Runner
-
     assert( 0 <= high - low );
-    const decltype(lid) size = high - low;
-    Runner **runners = new Runner *[size];		// do not use up task stack
-
-    for ( unsigned int lid = 0; lid < size; lid += 1 ) runners[lid] = new Runner( lid + low, f );
-    for ( unsigned int lid = 0; lid < size; lid += 1 ) delete runners[lid];
-    delete [] runners;
+    uParallelFor( (unsigned int)low, (unsigned int)high, f );
 } // uCofor
 
 // START/WAIT
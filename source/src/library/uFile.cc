@@ -51,10 +51,18 @@ int uFileIO::read( char *buf, int len, uDuration *timeout ) {
 
 	int action() {
 #ifdef __U_STATISTICS__
-	    uFetchAdd( UPP::Statistics::read_syscalls, 1 );
+	    uFetchAdd( UPP::Statistics::counters().read_syscalls, 1 );
 #endif // __U_STATISTICS__
 	    return ::read( access.fd, buf, len );
 	}
+	bool prep( UPP::uIOUringOp &op ) {
+	    op.opcode = UPP::uIOUringOp::Read;
+	    op.fd = access.fd;
+	    op.addr = buf;
+	    op.len = len;
+	    op.off = -1;				// current file position
+	    return true;
+	}
 	Read( uIOaccess &access, int &rlen ) : uIOClosure( access, rlen ) {}
     } readClosure( access, rlen );
 
@@ -70,10 +78,10 @@ int uFileIO::read( char *buf, int len, uDuration *timeout ) {
 #else
 	    readClosure.len = len - count;
 #endif // __U_READ_CHUNGKING__
-	    readClosure.wrapper();
+	    if ( ! readClosure.uring( timeout ) ) readClosure.wrapper(); // io_uring does not block processor on disk
 	    if ( rlen == -1 ) {
 #ifdef __U_STATISTICS__
-		uFetchAdd( UPP::Statistics::read_errors, 1 );
+		uFetchAdd( UPP::Statistics::counters().read_errors, 1 );
 #endif // __U_STATISTICS__
 		readFailure( readClosure.errno_, buf, len, timeout, "read" );
 	    } // if
@@ -82,23 +90,23 @@ int uFileIO::read( char *buf, int len, uDuration *timeout ) {
 	  if ( count == len ) break;			// transferred across all reads
 #ifdef __U_READ_CHUNGKING__
 #ifdef __U_STATISTICS__
-	    uFetchAdd( UPP::Statistics::read_chunking, 1 );
+	    uFetchAdd( UPP::Statistics::counters().read_chunking, 1 );
 #endif // __U_STATISTICS__
 	    uThisTask().yield();			// allow other tasks to make progress
 #endif // __U_READ_CHUNGKING__
 	} // for
 
 #ifdef __U_STATISTICS__
-	uFetchAdd( UPP::Statistics::read_bytes, count );
+	uFetchAdd( UPP::Statistics::counters().read_bytes, count );
 #endif // __U_STATISTICS__
 	return count;
     } else {
 	readClosure.buf = buf;
 	readClosure.len = len;
-	readClosure.wrapper();
+	if ( ! readClosure.uring( timeout ) ) readClosure.wrapper();
 	if ( rlen == -1 && readClosure.errno_ == U_EWOULDBLOCK ) {
 #ifdef __U_STATISTICS__
-	    uFetchAdd( UPP::Statistics::read_eagain, 1 );
+	    uFetchAdd( UPP::Statistics::counters().read_eagain, 1 );
 #endif // __U_STATISTICS__
 	    if ( ! readClosure.select( uCluster::ReadSelect, timeout ) ) {
 		readTimeout( buf, len, timeout, "read" );
@@ -106,13 +114,13 @@ int uFileIO::read( char *buf, int len, uDuration *timeout ) {
 	} // if
 	if ( rlen == -1 ) {
 #ifdef __U_STATISTICS__
-	    uFetchAdd( UPP::Statistics::read_errors, 1 );
+	    uFetchAdd( UPP::Statistics::counters().read_errors, 1 );
 #endif // __U_STATISTICS__
 	    readFailure( readClosure.errno_, buf, len, timeout, "read" );
 	} // if
 
 #ifdef __U_STATISTICS__
-	uFetchAdd( UPP::Statistics::read_bytes, rlen );
+	uFetchAdd( UPP::Statistics::counters().read_bytes, rlen );
 #endif // __U_STATISTICS__
 	return rlen;
     } // if
@@ -127,10 +135,18 @@ int uFileIO::readv( const struct iovec *iov, int iovcnt, uDuration *timeout ) {
 	int iovcnt;
 
 	int action() { return ::readv( access.fd, iov, iovcnt ); }
+	bool prep( UPP::uIOUringOp &op ) {
+	    op.opcode = UPP::uIOUringOp::Readv;
+	    op.fd = access.fd;
+	    op.addr = (void *)iov;
+	    op.len = iovcnt;
+	    op.off = -1;				// current file position
+	    return true;
+	}
 	Readv( uIOaccess &access, int &rlen, const struct iovec *iov, int iovcnt ) : uIOClosure( access, rlen ), iov( iov ), iovcnt( iovcnt ) {}
     } readvClosure( access, rlen, iov, iovcnt );
 
-    readvClosure.wrapper();
+    if ( ! readvClosure.uring( timeout ) ) readvClosure.wrapper();
     if ( rlen == -1 && readvClosure.errno_ == U_EWOULDBLOCK ) {
 	if ( ! readvClosure.select( uCluster::ReadSelect, timeout ) ) {
 	    readTimeout( (const char *)iov, iovcnt, timeout, "readv" );
@@ -141,7 +157,7 @@ int uFileIO::readv( const struct iovec *iov, int iovcnt, uDuration *timeout ) {
     } // if
 
 #ifdef __U_STATISTICS__
-    uFetchAdd( UPP::Statistics::read_bytes, rlen );
+    uFetchAdd( UPP::Statistics::counters().read_bytes, rlen );
 #endif // __U_STATISTICS__
     return rlen;
 } // uFileIO::readv
@@ -156,20 +172,28 @@ int uFileIO::write( const char *buf, int len, uDuration *timeout ) {
 
 	int action() {
 #ifdef __U_STATISTICS__
-	    uFetchAdd( UPP::Statistics::write_syscalls, 1 );
+	    uFetchAdd( UPP::Statistics::counters().write_syscalls, 1 );
 #endif // __U_STATISTICS__
 	    return ::write( access.fd, buf, len );
 	}
+	bool prep( UPP::uIOUringOp &op ) {
+	    op.opcode = UPP::uIOUringOp::Write;
+	    op.fd = access.fd;
+	    op.addr = (void *)buf;
+	    op.len = len;
+	    op.off = -1;				// current file position
+	    return true;
+	}
 	Write( uIOaccess &access, int &wlen ) : uIOClosure( access, wlen ) {}
     } writeClosure( access, wlen );
 
     for ( int count = 0;; ) {				// ensure all data is written
 	writeClosure.buf = buf + count;
 	writeClosure.len = len - count;
-	writeClosure.wrapper();
+	if ( ! writeClosure.uring( timeout ) ) writeClosure.wrapper();
 	if ( wlen == -1 && writeClosure.errno_ == U_EWOULDBLOCK ) {
 #ifdef __U_STATISTICS__
-	    uFetchAdd( UPP::Statistics::write_eagain, 1 );
+	    uFetchAdd( UPP::Statistics::counters().write_eagain, 1 );
 #endif // __U_STATISTICS__
 	    if ( ! writeClosure.select( uCluster::WriteSelect, timeout ) ) {
 		writeTimeout( buf, len, timeout, "write" );
@@ -180,7 +204,7 @@ int uFileIO::write( const char *buf, int len, uDuration *timeout ) {
 	    // work as if stdout is magically redirected to /dev/null, instead of aborting the program.
       if ( writeClosure.errno_ == EIO ) break;
 #ifdef __U_STATISTICS__
-	    uFetchAdd( UPP::Statistics::write_errors, 1 );
+	    uFetchAdd( UPP::Statistics::counters().write_errors, 1 );
 #endif // __U_STATISTICS__
 	    writeFailure( writeClosure.errno_, buf, len, timeout, "write" );
 	} // if
@@ -189,7 +213,7 @@ int uFileIO::write( const char *buf, int len, uDuration *timeout ) {
     } // for
 
 #ifdef __U_STATISTICS__
-    uFetchAdd( UPP::Statistics::write_bytes, len );
+    uFetchAdd( UPP::Statistics::counters().write_bytes, len );
 #endif // __U_STATISTICS__
     return len;						// always return the specified length
 } // uFileIO::write
@@ -203,10 +227,18 @@ int uFileIO::writev( const struct iovec *iov, int iovcnt, uDuration *timeout ) {
 	int iovcnt;
 
 	int action() { return ::writev( access.fd, iov, iovcnt ); }
+	bool prep( UPP::uIOUringOp &op ) {
+	    op.opcode = UPP::uIOUringOp::Writev;
+	    op.fd = access.fd;
+	    op.addr = (void *)iov;
+	    op.len = iovcnt;
+	    op.off = -1;				// current file position
+	    return true;
+	}
 	Writev( uIOaccess &access, int &wlen, const struct iovec *iov, int iovcnt ) : uIOClosure( access, wlen ), iov( iov ), iovcnt( iovcnt ) {}
     } writevClosure( access, wlen, iov, iovcnt );
 
-    writevClosure.wrapper();
+    if ( ! writevClosure.uring( timeout ) ) writevClosure.wrapper();
     if ( wlen == -1 && writevClosure.errno_ == U_EWOULDBLOCK ) {
 	if ( ! writevClosure.select( uCluster::WriteSelect, timeout ) ) {
 	    writeTimeout( (const char *)iov, iovcnt, timeout, "writev" );
@@ -219,7 +251,7 @@ int uFileIO::writev( const struct iovec *iov, int iovcnt, uDuration *timeout ) {
     } // if
 
 #ifdef __U_STATISTICS__
-    uFetchAdd( UPP::Statistics::write_bytes, wlen );
+    uFetchAdd( UPP::Statistics::counters().write_bytes, wlen );
 #endif // __U_STATISTICS__
     return wlen;
 } // uFileIO::writev
@@ -27,11 +27,22 @@
 #ifndef __U_FUTURE_H__
 #define __U_FUTURE_H__
 
+#if __cplusplus >= 201103L
+#include <utility>					// move
+#endif // __cplusplus >= 201103L
+
 
 //############################## uBaseFuture ##############################
 
 
 namespace UPP {
+    // Results are moved into and out of a future when the compiler supports it, so move-only result types work.
+#if __cplusplus >= 201103L
+    template<typename T> inline T &&uMove( T &t ) { return std::move( t ); }
+#else
+    template<typename T> inline T &uMove( T &t ) { return t; }
+#endif // __cplusplus >= 201103L
+
     template<typename T> _Monitor uBaseFuture {
 	T result;					// future result
       public:
@@ -57,7 +68,7 @@ namespace UPP {
 
 	void makeavailable() {
 	    available_ = true;
-	    while ( ! delay.empty() ) delay.signal();	// unblock waiting clients ?
+	    delay.signalAll();				// unblock waiting clients ?
 	    if ( ! acceptClients.empty() ) {		// select-blocked clients ?
 		UPP::BaseFutureDL *bt;			// unblock select-blocked clients
 		for ( uSeqIter<UPP::BaseFutureDL> iter( acceptClients ); iter >> bt; ) {
@@ -78,7 +89,7 @@ namespace UPP {
 
 	// USED BY CLIENT
 
-	T operator()() {				// access result, possibly having to wait
+	T &operator()() {				// access result, possibly having to wait
 	    check();					// cancelled or exception ?
 	    if ( ! available() ) {
 		delay.wait();
@@ -101,7 +112,7 @@ namespace UPP {
 
 	bool delivery( T res ) {			// make result available in the future
 	    if ( cancelled() || available() ) return false; // ignore, client does not want it or already set
-	    result = res;
+	    result = uMove( res );
 	    makeavailable();
 	    return true;
 	} // uBaseFuture::delivery
@@ -200,7 +211,7 @@ template<typename T, typename ServerData> _Monitor Future_ESM : public UPP::uBas
 	    makeavailable();
 	    return true;
 	} else {
-	    return UPP::uBaseFuture<T>::delivery( res );
+	    return UPP::uBaseFuture<T>::delivery( UPP::uMove( res ) );
 	} // if
     } // Future_ESM::delivery
 
@@ -231,19 +242,68 @@ UPP::BinarySelector< UPP::AndCondition, UPP::UnarySelector< Future_ESM< Result,
 
 // Future is responsible for storage management by using reference counts.  Can be copied.
 
+class uExecutor;
+template<typename T> class Future_ISM;
+
+namespace UPP {
+    // Continuations of a Future_ISM are kept in a list in the future and run in registration order by the task that
+    // makes the future available, either directly or by sending them to an executor.
+
+    template<typename T> struct uFutureContinuation {
+	uFutureContinuation *next;
+	virtual ~uFutureContinuation() {}
+	virtual void run( Future_ISM<T> &future ) = 0;
+    }; // uFutureContinuation
+
+    template<typename T, typename Action> struct uFutureLocal : public uFutureContinuation<T> { // run by delivering task
+	Action action;
+	uFutureLocal( Action action ) : action( action ) {}
+	void run( Future_ISM<T> &future ) { action( future ); }
+    }; // uFutureLocal
+
+    template<typename T, typename Action> struct uFutureBound { // action and its future, as an executor request
+	Future_ISM<T> future;
+	Action action;
+	uFutureBound( const Future_ISM<T> &future, Action action ) : future( future ), action( action ) {}
+	void operator()() { action( future ); }
+    }; // uFutureBound
+
+    template<typename T, typename Executor, typename Action> struct uFutureRemote : public uFutureContinuation<T> { // run by executor
+	Executor &executor;
+	Action action;
+	uFutureRemote( Executor &executor, Action action ) : executor( executor ), action( action ) {}
+	void run( Future_ISM<T> &future ) { executor.send( uFutureBound<T, Action>( future, action ) ); }
+    }; // uFutureRemote
+
+    template<typename T, typename R, typename F> struct uFutureChain { // deliver result of f, or its exception, to a future
+	Future_ISM<R> result;
+	F f;
+	uFutureChain( const Future_ISM<R> &result, F f ) : result( result ), f( f ) {}
+	void operator()( Future_ISM<T> &future ) {
+	    try {
+		result.delivery( f( future ) );
+	    } catch( uBaseEvent &ex ) {			// includes exception or cancellation of future
+		result.exception( ex.duplicate() );
+	    } // try
+	} // uFutureChain::operator()
+    }; // uFutureChain
+} // UPP
+
 template<typename T> class Future_ISM {
   public:
     struct ServerData {
 	virtual ~ServerData() {}
 	virtual bool cancel() = 0;
     };
+    class Pool;
   private:
     _Monitor Impl : public UPP::uBaseFuture<T> {	// mutual exclusion implementation
 	using UPP::uBaseFuture<T>::cancelled_;
 	using UPP::uBaseFuture<T>::cause;
 
-	unsigned int refCnt;				// number of references to future
+	volatile unsigned int refCnt;			// number of references to future
 	ServerData *serverData;
+	UPP::uFutureContinuation<T> *continuations;	// registered after last, not yet run
       public:
 	using UPP::uBaseFuture<T>::available;
 	using UPP::uBaseFuture<T>::reset;
@@ -252,40 +312,146 @@ template<typename T> class Future_ISM {
 	using UPP::uBaseFuture<T>::delay;
 	using UPP::uBaseFuture<T>::cancelled;
 
-	Impl() : refCnt( 1 ), serverData( NULL ) {}
-	Impl( ServerData *serverData_ ) : refCnt( 1 ), serverData( serverData_ ) {}
+	bool heap;					// storage allocated by future
+	Pool *pool;					// storage from pool, returned when unreferenced
+
+	Impl( ServerData *serverData_, bool heap, Pool *pool ) : refCnt( 1 ), serverData( serverData_ ), continuations( NULL ), heap( heap ), pool( pool ) {}
 
 	~Impl() {
 	    delete serverData;
+	    delete cause;
+	    for ( UPP::uFutureContinuation<T> *c = continuations; c != NULL; ) { // never available, never run
+		UPP::uFutureContinuation<T> *next = c->next;
+		delete c;
+		c = next;
+	    } // for
 	} // Impl::~Impl
 
-	void incRef() {
-	    refCnt += 1;
+	_Nomutex void incRef() {
+	    uFetchAdd( refCnt, 1 );
 	} // Impl::incRef
 
-	bool decRef() {
-	    refCnt -= 1;
-	  if ( refCnt != 0 ) return false;
-	    delete cause;
-	    return true;
+	_Nomutex bool decRef() {			// true => last reference
+	    return uFetchAdd( refCnt, -1 ) == 1;
 	} // Impl::decRef
 
-	void cancel() {					// cancel future result
-	  if ( available() ) return;			// already available, can't cancel
-	  if ( cancelled() ) return;			// only cancel once
+	bool cancel() {					// cancel future result
+	  if ( available() ) return false;		// already available, can't cancel
+	  if ( cancelled() ) return false;		// only cancel once
 	    cancelled_ = true;
 	    if ( serverData != NULL ) serverData->cancel();
 	    makeavailable();				// unblock waiting clients ?
+	    return true;
 	} // Impl::cancel
+
+	bool add( UPP::uFutureContinuation<T> *continuation ) { // false => already available
+	  if ( available() ) return false;
+	    continuation->next = continuations;
+	    continuations = continuation;
+	    return true;
+	} // Impl::add
+
+	_Nomutex UPP::uFutureContinuation<T> *take() {	// only after future made available, so no more are added
+	    UPP::uFutureContinuation<T> *c = continuations;
+	    continuations = NULL;
+	    return c;
+	} // Impl::take
     }; // Impl
 
     Impl *impl;						// storage for implementation
+
+    static void release( Impl *impl ) {
+      if ( ! impl->decRef() ) return;
+	if ( impl->heap ) {
+	    delete impl;
+	} else {
+	    Pool *pool = impl->pool;
+	    impl->~Impl();
+	    if ( pool != NULL ) pool->free( impl );
+	} // if
+    } // Future_ISM::release
+
+    void resume() {					// future made available => run continuations in order
+	UPP::uFutureContinuation<T> *c = impl->take(), *ordered = NULL;
+      if ( c == NULL ) return;				// common case
+	while ( c != NULL ) {				// reverse list
+	    UPP::uFutureContinuation<T> *next = c->next;
+	    c->next = ordered;
+	    ordered = c;
+	    c = next;
+	} // while
+	while ( ordered != NULL ) {
+	    c = ordered;
+	    ordered = c->next;
+	    c->run( *this );
+	    delete c;
+	} // while
+    } // Future_ISM::resume
+
+    void add( UPP::uFutureContinuation<T> *continuation ) {
+	if ( ! impl->add( continuation ) ) {		// already available => run now
+	    continuation->run( *this );
+	    delete continuation;
+	} // if
+    } // Future_ISM::add
   public:
-    Future_ISM() : impl( new Impl ) {}
-    Future_ISM( ServerData *serverData ) : impl( new Impl( serverData ) ) {}
+    // Caller-provided storage for a future, which must outlive all copies of the future.
+
+    class Storage {
+	friend class Future_ISM<T>;
+	char storage[sizeof(Impl)] __attribute__(( aligned ));
+    }; // Storage
+
+    // Recycled storage for futures; a future constructed from a pool returns its storage to the pool when the last copy
+    // is deleted, so the pool must outlive its futures.
+
+    class Pool {
+	friend class Future_ISM<T>;
+	union Node {
+	    Node *next;
+	    Storage storage;
+	}; // Node
+
+	uSpinLock lock;
+	Node *freeList;
+
+	Pool( Pool & );					// no copy
+	Pool &operator=( Pool & );			// no assignment
+
+	void *alloc() {
+	    lock.acquire();
+	    Node *node = freeList;
+	    if ( node != NULL ) freeList = node->next;
+	    lock.release();
+	    return node != NULL ? node : ::operator new( sizeof(Node) );
+	} // Pool::alloc
+
+	void free( void *storage ) {
+	    Node *node = (Node *)storage;
+	    lock.acquire();
+	    node->next = freeList;
+	    freeList = node;
+	    lock.release();
+	} // Pool::free
+      public:
+	Pool() : freeList( NULL ) {}
+
+	~Pool() {
+	    while ( freeList != NULL ) {
+		Node *node = freeList;
+		freeList = node->next;
+		::operator delete( node );
+	    } // while
+	} // Pool::~Pool
+    }; // Pool
+
+    Future_ISM() : impl( new Impl( NULL, true, NULL ) ) {}
+    Future_ISM( ServerData *serverData ) : impl( new Impl( serverData, true, NULL ) ) {}
+    Future_ISM( Storage &storage, ServerData *serverData = NULL ) : impl( new( storage.storage ) Impl( serverData, false, NULL ) ) {}
+    Future_ISM( Pool &pool, ServerData *serverData = NULL ) : impl( new( pool.alloc() ) Impl( serverData, false, &pool ) ) {}
 
     ~Future_ISM() {
-	if ( impl->decRef() ) delete impl;
+	release( impl );
     } // Future_ISM::~Future_ISM
 
     Future_ISM( const Future_ISM<T> &rhs ) {
@@ -295,9 +461,9 @@ template<typename T> class Future_ISM {
 
     Future_ISM<T> &operator=( const Future_ISM<T> &rhs ) {
       if ( rhs.impl == impl ) return *this;
-	if ( impl->decRef() ) delete impl;		// no references => delete current impl
+	rhs.impl->incRef();				// increment reference count
+	release( impl );				// no references => delete current impl
 	impl = rhs.impl;				// point at new impl
-	impl->incRef();					//   and increment reference count
 	return *this;
     } // Future_ISM::operator=
 
@@ -308,7 +474,7 @@ template<typename T> class Future_ISM {
     bool available() { return impl->available(); }	// future result available ?
     bool cancelled() { return impl->cancelled(); }	// future result cancelled ?
 
-    T operator()() {					// access result, possibly having to wait
+    T &operator()() {					// access result, possibly having to wait
 	return (*impl)();
     } // Future_ISM::operator()()
 
@@ -317,7 +483,7 @@ template<typename T> class Future_ISM {
     } // Future_ISM::operator T()
 
     void cancel() {					// cancel future result
-	impl->cancel();
+	if ( impl->cancel() ) resume();
     } // Future_ISM::cancel
 
     bool addAccept( UPP::BaseFutureDL *acceptState ) {
@@ -332,14 +498,43 @@ template<typename T> class Future_ISM {
 	return impl == other.impl;
     } // Future_ISM::equals
 
+    // Continuations: when the future is available (result, exception, or cancellation), call f( future ) on the task
+    // that makes it available, or on the calling task if it is already available, or send the call to an executor. The
+    // forms with result type R return a future for the value returned by f, or the exception raised by f, so a chain
+    // of dependent calls needs no blocked task per stage.
+
+    template<typename F> void then( F f ) {
+	add( new UPP::uFutureLocal<T, F>( f ) );
+    } // Future_ISM::then
+
+    template<typename R, typename F> Future_ISM<R> then( F f ) {
+	Future_ISM<R> result;
+	add( new UPP::uFutureLocal<T, UPP::uFutureChain<T, R, F> >( UPP::uFutureChain<T, R, F>( result, f ) ) );
+	return result;
+    } // Future_ISM::then
+
+    template<typename F> void then( uExecutor &executor, F f ) {
+	add( new UPP::uFutureRemote<T, uExecutor, F>( executor, f ) );
+    } // Future_ISM::then
+
+    template<typename R, typename F> Future_ISM<R> then( uExecutor &executor, F f ) {
+	Future_ISM<R> result;
+	add( new UPP::uFutureRemote<T, uExecutor, UPP::uFutureChain<T, R, F> >( executor, UPP::uFutureChain<T, R, F>( result, f ) ) );
+	return result;
+    } // Future_ISM::then
+
     // USED BY SERVER
 
     bool delivery( T result ) {				// make result available in the future
-	return impl->delivery( result );
+      if ( ! impl->delivery( UPP::uMove( result ) ) ) return false;
+	resume();
+	return true;
     } // Future_ISM::delivery
 
     bool exception( uBaseEvent *cause ) {		// make exception available in the future
-	return impl->exception( cause );
+      if ( ! impl->exception( cause ) ) return false;
+	resume();
+	return true;
     } // Future_ISM::exception
 
     void reset() {					// mark future as empty (for reuse)
@@ -545,10 +740,77 @@ class uExecutor {
 	} // Buffer::remove
     }; // Buffer
 
+    // Bounded lock-free multi-producer/multi-consumer queue. Each cell carries a sequence number telling producers and
+    // consumers whose turn it is, so a push or pop is one compare-and-assign on the tail or head position.
+    template<typename T> class BoundedQueue {
+	struct Cell {
+	    volatile size_t sequence;
+	    T volatile data;
+	}; // Cell
+
+	Cell *cells;
+	const size_t mask;				// size - 1, size is a power of 2
+	volatile size_t head;				// next cell to pop
+	char padding[64];				// separate consumers and producers
+	volatile size_t tail;				// next cell to push
+
+	BoundedQueue( BoundedQueue & );			// no copy
+	BoundedQueue &operator=( BoundedQueue & );	// no assignment
+      public:
+	BoundedQueue( size_t size ) : mask( size - 1 ), head( 0 ), tail( 0 ) {
+	    assert( size != 0 && (size & (size - 1)) == 0 ); // power of 2
+	    cells = new Cell[size];
+	    for ( size_t i = 0; i < size; i += 1 ) cells[i].sequence = i;
+	} // BoundedQueue::BoundedQueue
+
+	~BoundedQueue() {
+	    delete [] cells;
+	} // BoundedQueue::~BoundedQueue
+
+	bool push( T data ) {
+	    for ( ;; ) {
+		size_t pos = tail;
+		Cell &cell = cells[pos & mask];
+		long int diff = (long int)(cell.sequence - pos);
+		if ( diff == 0 ) {			// cell free ?
+		    if ( uCompareAssign( tail, pos, pos + 1 ) ) {
+			cell.data = data;
+			cell.sequence = pos + 1;	// publish to consumers
+			return true;
+		    } // if
+		} else if ( diff < 0 ) {		// full ?
+		    return false;
+		} // if
+	    } // for
+	} // BoundedQueue::push
+
+	bool pop( T &data ) {
+	    for ( ;; ) {
+		size_t pos = head;
+		Cell &cell = cells[pos & mask];
+		long int diff = (long int)(cell.sequence - (pos + 1));
+		if ( diff == 0 ) {			// cell full ?
+		    if ( uCompareAssign( head, pos, pos + 1 ) ) {
+			data = cell.data;
+			cell.sequence = pos + mask + 1;	// release to producers of next lap
+			return true;
+		    } // if
+		} else if ( diff < 0 ) {		// empty ?
+		    return false;
+		} // if
+	    } // for
+	} // BoundedQueue::pop
+
+	bool empty() const {
+	    return (long int)(cells[head & mask].sequence - (head + 1)) < 0;
+	} // BoundedQueue::empty
+    }; // BoundedQueue
+
     class WRequest : public uSeqable {			// worker request
 	bool done;
       public:
-	WRequest( bool done = false ) : done( done ) {}
+	bool pooled;					// storage from executor request pool
+	WRequest( bool done = false ) : done( done ), pooled( false ) {}
 	virtual ~WRequest() {};
 	virtual bool stop() { return done; };
 	virtual void doit() {};
@@ -561,10 +823,29 @@ class uExecutor {
 	CRequest( F action ) : action( action ) {}
     }; // CRequest
 
+    template<typename F> struct SRequest : public WRequest { // client request without result
+	F action;
+	void doit() { action(); }
+	SRequest( F action ) : action( action ) {}
+    }; // SRequest
+
+    struct Deque {					// per-worker requests, owner takes head, thieves take tail
+	uSpinLock lock;
+	uSequence<WRequest> requests;
+	volatile unsigned int count;
+	char padding[64];				// reduce false sharing among workers
+	Deque() : count( 0 ) {}
+    }; // Deque
+
     _Task Worker {
 	uExecutor &executor;
+	unsigned int id;
 
 	void main() {
+	    if ( executor.stealing ) {
+		executor.work( id );
+		return;
+	    } // if
 	    for ( ;; ) {
 		WRequest *request = executor.requests.remove();
 	      if ( request->stop() ) break;
@@ -573,35 +854,181 @@ class uExecutor {
 	    } // for
 	} // Worker::main
       public:
-	Worker( uCluster &wc, uExecutor &executor ) : uBaseTask( wc ), executor( executor ) {}
+	Worker( uCluster &wc, uExecutor &executor, unsigned int id ) : uBaseTask( wc ), executor( executor ), id( id ) {}
     }; // Worker
 
+    enum { InjectionSize = 4096,			// maximum outstanding requests in injection queue
+	   PoolSize = 4096,				// maximum recycled request nodes
+	   PoolSlot = 128,				// request node size in pool
+	   Batch = 16 };				// requests moved from injection queue to worker at a time
+
     const unsigned int nworkers;			// number of workers tasks
+    const bool stealing;				// per-worker deques and lock-free injection queue
     Buffer<WRequest> requests;				// list of work requests
     Worker **workers;					// array of workers executing work requests
     uProcessor **processors;				//   corresponding number of virtual processors
     uCluster *cluster;					// workers execute on separate cluster
+
+    // stealing mode
+    BoundedQueue<WRequest *> *injection;		// submitted requests
+    BoundedQueue<void *> *pool;				// recycled request storage
+    Deque *deques;					// per-worker requests
+    UPP::uSemaphore idle;				// parked workers
+    volatile unsigned int idlers;			// workers parked or about to park
+    volatile unsigned int overflow;			// next deque for requests when injection queue full
+    volatile bool stopping;
+
+    template<typename Request> void *allocate() {
+	void *storage;
+	if ( sizeof(Request) <= PoolSlot && pool->pop( storage ) ) return storage;
+	return ::operator new( sizeof(Request) <= PoolSlot ? (size_t)PoolSlot : sizeof(Request) );
+    } // uExecutor::allocate
+
+    template<typename Request> WRequest *prepare( Request *request ) {
+	request->pooled = sizeof(Request) <= PoolSlot;
+	return request;
+    } // uExecutor::prepare
+
+    void recycle( WRequest *request ) {
+	bool pooled = request->pooled;
+	request->~WRequest();
+	if ( ! pooled || ! pool->push( request ) ) ::operator delete( request );
+    } // uExecutor::recycle
+
+    void wake() {					// unpark a worker if any are parked
+	__sync_synchronize();				// request visible before checking for idle workers
+	for ( ;; ) {
+	    unsigned int w = idlers;
+	  if ( w == 0 ) return;
+	    if ( uCompareAssign( idlers, w, w - 1 ) ) {
+		idle.V();
+		return;
+	    } // if
+	} // for
+    } // uExecutor::wake
+
+    void insert( WRequest *request ) {
+	if ( injection->push( request ) ) return;
+	// Injection queue full, so add to a worker's deque rather than block, as the submitter may be a worker.
+	Deque &deque = deques[uFetchAdd( overflow, 1 ) % nworkers];
+	deque.lock.acquire();
+	deque.requests.addTail( request );
+	deque.count += 1;
+	deque.lock.release();
+    } // uExecutor::insert
+
+    bool available() const {				// any request anywhere ?
+	if ( ! injection->empty() ) return true;
+	for ( unsigned int i = 0; i < nworkers; i += 1 ) {
+	    if ( deques[i].count != 0 ) return true;
+	} // for
+	return false;
+    } // uExecutor::available
+
+    void park() {
+	uFetchAdd( idlers, 1 );
+	if ( available() || stopping ) {		// recheck after announcing park
+	    for ( ;; ) {				// undo announcement
+		unsigned int w = idlers;
+		if ( w == 0 ) {				// waker already took it => consume its V
+		    idle.P();
+		    return;
+		} // if
+		if ( uCompareAssign( idlers, w, w - 1 ) ) return;
+	    } // for
+	} // if
+	idle.P();
+    } // uExecutor::park
+
+    WRequest *take( unsigned int id ) {
+	Deque &mine = deques[id];
+	WRequest *request = NULL;
+	if ( mine.count != 0 ) {
+	    mine.lock.acquire();
+	    request = mine.requests.dropHead();
+	    if ( request != NULL ) mine.count -= 1;
+	    mine.lock.release();
+	    if ( request != NULL ) return request;
+	} // if
+
+	if ( injection->pop( request ) ) {		// take batch from injection queue
+	    WRequest *extra;
+	    mine.lock.acquire();
+	    for ( unsigned int n = 1; n < Batch && injection->pop( extra ); n += 1 ) {
+		mine.requests.addTail( extra );
+		mine.count += 1;
+	    } // for
+	    mine.lock.release();
+	    return request;
+	} // if
+
+	for ( unsigned int i = 1; i < nworkers; i += 1 ) { // steal half of another worker's requests
+	    Deque &victim = deques[(id + i) % nworkers];
+	  if ( victim.count == 0 ) continue;
+	    uSequence<WRequest> stolen;
+	    victim.lock.acquire();
+	    unsigned int half = (victim.count + 1) / 2;
+	    for ( unsigned int n = 0; n < half; n += 1 ) stolen.addHead( victim.requests.dropTail() );
+	    victim.count -= half;
+	    victim.lock.release();
+	    request = stolen.dropHead();
+	  if ( request == NULL ) continue;		// raced with owner
+	    mine.lock.acquire();
+	    mine.count += half - 1;
+	    mine.requests.transfer( stolen );
+	    mine.lock.release();
+	    return request;
+	} // for
+	return NULL;
+    } // uExecutor::take
+
+    void work( unsigned int id ) {
+	for ( ;; ) {
+	    WRequest *request = take( id );
+	    if ( request == NULL ) {
+	      if ( stopping ) break;			// all requests done
+		park();
+		continue;
+	    } // if
+	    request->doit();
+	    recycle( request );
+	} // for
+    } // uExecutor::work
   public:
-    uExecutor( unsigned int nworkers = 4 ) : nworkers( nworkers ) {
+    // A stealing executor queues requests in a bounded lock-free injection queue, from which workers take batches into
+    // their own deques, and idle workers steal from other workers' deques or park on a semaphore.
+    uExecutor( unsigned int nworkers = 4, bool stealing = false ) : nworkers( nworkers ), stealing( stealing ), idle( 0 ), idlers( 0 ), overflow( 0 ), stopping( false ) {
 #if defined( __U_SEPARATE_CLUSTER__ )
 	cluster = new uCluster;
 #else
 	cluster = &uThisCluster();
 #endif // __U_SEPARATE_CLUSTER__
+	if ( stealing ) {
+	    injection = new BoundedQueue<WRequest *>( InjectionSize );
+	    pool = new BoundedQueue<void *>( PoolSize );
+	    deques = new Deque[ nworkers ];
+	} // if
 	processors = new uProcessor *[ nworkers ];
 	workers = new Worker *[ nworkers ];
 
 	for ( unsigned int i = 0; i < nworkers; i += 1 ) {
 	    processors[ i ] = new uProcessor( *cluster );
-	    workers[ i ] = new Worker( *cluster, *this );
+	    workers[ i ] = new Worker( *cluster, *this, i );
 	} // for
     } // uExecutor::uExecutor
 
     ~uExecutor() {
-	WRequest sentinel( true );
-	for ( unsigned int i = 0; i < nworkers; i += 1 ) {
-	    requests.insert( &sentinel );
-	} // for
+	WRequest *sentinels = NULL;
+	if ( stealing ) {
+	    stopping = true;				// workers finish outstanding requests and stop
+	    idle.V( nworkers );
+	} else {
+	    sentinels = new WRequest[ nworkers ];	// separate node per worker, as a node can only be on a list once
+	    for ( unsigned int i = 0; i < nworkers; i += 1 ) {
+		sentinels[ i ] = WRequest( true );
+		requests.insert( &sentinels[ i ] );
+	    } // for
+	} // if
 	unsigned int i;
 	for ( i = 0; i < nworkers; i += 1 ) {
 	    delete workers[ i ];
@@ -609,16 +1036,64 @@ class uExecutor {
 	} // for
 	delete [] workers;
 	delete [] processors;
+	delete [] sentinels;
+	if ( stealing ) {
+	    delete [] deques;
+	    void *storage;
+	    while ( pool->pop( storage ) ) ::operator delete( storage );
+	    delete pool;
+	    delete injection;
+	} // if
 #if defined( __U_SEPARATE_CLUSTER__ )
 	delete cluster;
 #endif // __U_SEPARATE_CLUSTER__
     } // uExecutor::~uExecutor
 
     template <typename Return, typename Func> void submit( Future_ISM<Return> &result, Func action ) {
+	if ( stealing ) {
+	    CRequest<Return,Func> *node = new( allocate< CRequest<Return,Func> >() ) CRequest<Return,Func>( action );
+	    result = node->result;			// race, copy before insert
+	    insert( prepare( node ) );
+	    wake();
+	    return;
+	} // if
 	CRequest<Return,Func> *node = new CRequest<Return,Func>( action );
 	result = node->result;				// race, copy before insert
 	requests.insert( node );
     } // uExecutor::submit
+
+    template <typename Return, typename Func> void submit( Future_ISM<Return> results[], Func actions[], unsigned int n ) {
+	if ( stealing ) {				// batch: one wakeup check for all requests
+	    for ( unsigned int i = 0; i < n; i += 1 ) {
+		CRequest<Return,Func> *node = new( allocate< CRequest<Return,Func> >() ) CRequest<Return,Func>( actions[i] );
+		results[i] = node->result;		// race, copy before insert
+		insert( prepare( node ) );
+	    } // for
+	    for ( unsigned int i = 0; i < n && i < nworkers; i += 1 ) wake();
+	    return;
+	} // if
+	for ( unsigned int i = 0; i < n; i += 1 ) submit( results[i], actions[i] );
+    } // uExecutor::submit
+
+    template <typename Func> void send( Func action ) { // no result
+	if ( stealing ) {
+	    insert( prepare( new( allocate< SRequest<Func> >() ) SRequest<Func>( action ) ) );
+	    wake();
+	    return;
+	} // if
+	requests.insert( new SRequest<Func>( action ) );
+    } // uExecutor::send
+
+    template <typename Func> void send( Func actions[], unsigned int n ) { // batch, no results
+	if ( stealing ) {
+	    for ( unsigned int i = 0; i < n; i += 1 ) {
+		insert( prepare( new( allocate< SRequest<Func> >() ) SRequest<Func>( actions[i] ) ) );
+	    } // for
+	    for ( unsigned int i = 0; i < n && i < nworkers; i += 1 ) wake();
+	    return;
+	} // if
+	for ( unsigned int i = 0; i < n; i += 1 ) send( actions[i] );
+    } // uExecutor::send
 }; // uExecutor
 
 
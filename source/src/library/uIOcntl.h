@@ -75,7 +75,27 @@ struct uIOClosure {
 	return true;
     } // uIOClosure::select
 
+    // Perform the operation through the cluster's io_uring, if enabled and the closure describes the operation. The
+    // task blocks until the completion is reaped, so the operation never fails with EWOULDBLOCK. Returns false if the
+    // operation was not performed, and the caller uses wrapper/select instead.
+
+    bool uring( uDuration *timeout ) {
+	UPP::uIOUringOp op = UPP::uIOUringOp();		// unused fields are zero
+      if ( timeout != NULL || ! uThisCluster().getIOUring() || ! prep( op ) ) return false; // timeouts use select
+	for ( ;; ) {
+	    retcode = uThisCluster().uring( op );
+	  if ( retcode != -EINTR ) break;
+	} // for
+      if ( retcode == -EAGAIN ) return false;		// kernel cannot wait for fd (older kernels)
+	if ( retcode < 0 ) {
+	    errno_ = -retcode;				// io_uring returns negative errno
+	    retcode = -1;
+	} // if
+	return true;
+    } // uIOClosure::uring
+
     virtual int action() = 0;
+    virtual bool prep( UPP::uIOUringOp & ) { return false; } // describe operation for io_uring
 }; // uIOClosure
 
 
@@ -51,11 +51,11 @@ class uRWLock {
 	task.info = kind;				// store the kind with this task
 	waiting.addTail( &(task.entryRef) );		// block current task
 #ifdef __U_STATISTICS__
-	uFetchAdd( UPP::Statistics::owner_lock_queue, 1 );
+	uFetchAdd( UPP::Statistics::counters().owner_lock_queue, 1 );
 #endif // __U_STATISTICS__
 	UPP::uProcessorKernel::schedule( &entry );	// atomically release spin lock and block
 #ifdef __U_STATISTICS__
-	uFetchAdd( UPP::Statistics::owner_lock_queue, -1 );
+	uFetchAdd( UPP::Statistics::counters().owner_lock_queue, -1 );
 #endif // __U_STATISTICS__
     } // uRWLock::block
   public:
@@ -104,19 +104,16 @@ class uRWLock {
 		for ( ;; ) {				// more readers ?
 		    rcnt += 1;
 		    rwdelay -= 1;
-		    n->task().setState( uBaseTask::Ready );
 		  if ( rwdelay == 0 || waiting.succ( n )->task().info != READER ) break;
 		    n = waiting.succ( n );
 		} // for
-		uSequence<uBaseTaskDL> unblock;
-		int lrcnt = rcnt;
+		uSequence<uBaseTaskDL> unblock, released;
 		unblock.split( waiting, n );
 		entry.release();			// put baton down
-//		for ( n = unblock.dropHead(); n != NULL; n = unblock.dropHead() ) {
-//		    cout << &uThisTask() << " " << n << " " << n->task().info << endl;
-//		    n->task().wake();			// and wake task
-//		} // for
-		uThisCluster().makeTaskReady( unblock, lrcnt );
+		for ( n = unblock.dropHead(); n != NULL; n = unblock.dropHead() ) {
+		    released.addTail( &(n->task().readyRef) );
+		} // for
+		uBaseTask::wake( released );		// and wake readers together
 	    } // if
 	} else {
 	    entry.release();				// put baton down
@@ -125,6 +122,84 @@ class uRWLock {
 }; // uRWLock
 
 
+// Reader-writer lock for read-mostly data. Each reader increments and decrements a reader counter for the processor it
+// is running on, so readers on different processors write different cache lines, and a reader never writes a line
+// shared with the other readers when no writer is present. A writer first acquires the embedded uRWLock as a writer,
+// which orders it with other writers and with readers that arrived while a writer was present, and then waits until
+// the reader counters sum to zero. Readers that find a writer present back out and queue on the embedded lock in FIFO
+// order, so writers are not starved. A reader may migrate while holding the lock, so a counter can be decremented on a
+// different processor than it was incremented; only the sum is meaningful.
+
+class uScalableRWLock {
+    enum { Slots = 16 };				// reader counters, processors hash onto them
+
+    struct Slot {
+	volatile int count;				// readers that incremented here minus readers that decremented here
+	char padding[128 - sizeof(int)];		// pad to size of cacheline
+    }; // Slot
+
+    Slot slots[Slots];
+    uRWLock rw;						// writers, and readers that arrive while a writer is present
+    volatile bool writer;				// writer present or draining readers
+    volatile bool draining;				// writer waiting for reader counters to reach zero
+    UPP::uSemaphore drained;				// draining writer blocks here
+
+    uScalableRWLock( uScalableRWLock & );		// no copy
+    uScalableRWLock &operator=( uScalableRWLock & );	// no assignment
+
+    Slot &slot() {					// counter for the current processor
+	uintptr_t p = (uintptr_t)&uThisProcessor();	// processors are heap objects of the same size, so fold in high bits
+	return slots[( ( p >> 6 ) ^ ( p >> 11 ) ^ ( p >> 16 ) ) % Slots];
+    } // uScalableRWLock::slot
+
+    int readers() const {				// at least the number of readers holding the lock
+	int sum = 0;
+	for ( unsigned int i = 0; i < Slots; i += 1 ) sum += slots[i].count;
+	return sum;
+    } // uScalableRWLock::readers
+
+    void depart( Slot &s ) {
+	uFetchAdd( s.count, -1 );
+	if ( draining && readers() == 0 && uCompareAssign( draining, true, false ) ) { // last reader before writer ?
+	    drained.V();				// restart writer
+	} // if
+    } // uScalableRWLock::depart
+  public:
+    uScalableRWLock() : writer( false ), draining( false ), drained( 0 ) {
+	for ( unsigned int i = 0; i < Slots; i += 1 ) slots[i].count = 0;
+    } // uScalableRWLock::uScalableRWLock
+
+    void rdacquire() {
+	Slot &s = slot();
+	uFetchAdd( s.count, 1 );			// announce reader, full barrier before checking for writer
+      if ( ! writer ) return;				// no writer => lock acquired
+	depart( s );					// back out
+	rw.rdacquire();					// queue behind writer
+	uFetchAdd( slot().count, 1 );			// no writer can be draining while the read lock is held
+	rw.rdrelease();
+    } // uScalableRWLock::rdacquire
+
+    void rdrelease() {
+	depart( slot() );
+    } // uScalableRWLock::rdrelease
+
+    void wracquire() {
+	rw.wracquire();					// exclude other writers and queued readers
+	writer = true;
+	draining = true;
+	__sync_synchronize();				// announce writer before examining reader counters
+	if ( readers() != 0 || ! uCompareAssign( draining, true, false ) ) {
+	    drained.P();				// wait for last reader
+	} // if
+    } // uScalableRWLock::wracquire
+
+    void wrrelease() {
+	writer = false;
+	rw.wrrelease();					// restart queued readers or next writer
+    } // uScalableRWLock::wrrelease
+}; // uScalableRWLock
+
+
 #endif // __U_RWLOCK_H__
 
 
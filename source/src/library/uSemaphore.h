@@ -42,7 +42,7 @@ _Monitor uSemaphore {
   public:
     uSemaphore( int count = 1 ) : count( count ) {
 #ifdef __U_STATISTICS__
-	    uFetchAdd( UPP::Statistics::uSemaphores, 1 );
+	    uFetchAdd( UPP::Statistics::counters().uSemaphores, 1 );
 #endif // __U_STATISTICS__
 #ifdef __U_DEBUG__
 	if ( count < 0 ) {
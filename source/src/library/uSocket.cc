@@ -37,6 +37,9 @@
 #if defined( __solaris__ ) || defined( __linux__ )
 #include <sys/sendfile.h>
 #endif // __solaris__ || __linux__
+#if defined( __linux__ )
+#include <fcntl.h>					// splice, pipe2
+#endif // __linux__
 
 #ifndef SUN_LEN
 #define SUN_LEN(su) (sizeof(*(su)) - sizeof((su)->sun_path) + strlen((su)->sun_path))
@@ -189,10 +192,18 @@ int uSocketIO::send( char *buf, int len, int flags, uDuration *timeout ) {
 	int flags;
 
 	int action() { return ::send( access.fd, buf, len, flags ); }
+	bool prep( UPP::uIOUringOp &op ) {
+	    op.opcode = UPP::uIOUringOp::Send;
+	    op.fd = access.fd;
+	    op.addr = buf;
+	    op.len = len;
+	    op.flags = flags;
+	    return true;
+	}
 	Send( uIOaccess &access, int &slen, char *buf, int len, int flags ) : uIOClosure( access, slen ), buf( buf ), len( len ), flags( flags ) {}
     } sendClosure( access, slen, buf, len, flags );
 
-    sendClosure.wrapper();
+    if ( ! sendClosure.uring( timeout ) ) sendClosure.wrapper();
     if ( slen == -1 && sendClosure.errno_ == U_EWOULDBLOCK ) {
 	if ( ! sendClosure.select( uCluster::WriteSelect, timeout ) ) {
 	    writeTimeout( buf, len, flags, NULL, 0, timeout, "send" );
@@ -244,10 +255,18 @@ int uSocketIO::recv( char *buf, int len, int flags, uDuration *timeout ) {
 	int flags;
 
 	int action() { return ::recv( access.fd, buf, len, flags ); }
+	bool prep( UPP::uIOUringOp &op ) {
+	    op.opcode = UPP::uIOUringOp::Recv;
+	    op.fd = access.fd;
+	    op.addr = buf;
+	    op.len = len;
+	    op.flags = flags;
+	    return true;
+	}
 	Recv( uIOaccess &access, int &rlen, char *buf, int len, int flags ) : uIOClosure( access, rlen ), buf( buf ), len( len ), flags( flags ) {}
     } recvClosure( access, rlen, buf, len, flags );
 
-    recvClosure.wrapper();
+    if ( ! recvClosure.uring( timeout ) ) recvClosure.wrapper();
     if ( rlen == -1 && recvClosure.errno_ == U_EWOULDBLOCK ) {
 	if ( ! recvClosure.select( uCluster::ReadSelect, timeout ) ) {
 	    readTimeout( buf, len, flags, NULL, NULL, timeout, "recv" );
@@ -302,10 +321,18 @@ int uSocketIO::recvmsg( struct msghdr *msg, int flags, uDuration *timeout ) {
 	int flags;
 
 	int action() { return ::recvmsg( access.fd, msg, flags ); }
+	bool prep( UPP::uIOUringOp &op ) {
+	    op.opcode = UPP::uIOUringOp::Recvmsg;
+	    op.fd = access.fd;
+	    op.addr = msg;
+	    op.len = 1;					// one msghdr
+	    op.flags = flags;
+	    return true;
+	}
 	Recvmsg( uIOaccess &access, int &rlen, struct msghdr *msg, int flags ) : uIOClosure( access, rlen ), msg( msg ), flags( flags ) {}
     } recvmsgClosure( access, rlen, msg, flags );
 
-    recvmsgClosure.wrapper();
+    if ( ! recvmsgClosure.uring( timeout ) ) recvmsgClosure.wrapper();
     if ( rlen == -1 && recvmsgClosure.errno_ == U_EWOULDBLOCK ) {
 	if ( ! recvmsgClosure.select( uCluster::ReadSelect, timeout ) ) {
 	    readTimeout( (const char *)msg, 0, flags, NULL, NULL, timeout, "recvmsg" );
@@ -319,6 +346,96 @@ int uSocketIO::recvmsg( struct msghdr *msg, int flags, uDuration *timeout ) {
 } // uSocketIO::recvmsg
 
 
+int uSocketIO::sendmsg( const struct msghdr *msg, int flags, uDuration *timeout ) {
+    int slen;
+
+    struct Sendmsg : public uIOClosure {
+	const struct msghdr *msg;
+	int flags;
+
+	int action() { return ::sendmsg( access.fd, msg, flags ); }
+	bool prep( UPP::uIOUringOp &op ) {
+	    op.opcode = UPP::uIOUringOp::Sendmsg;
+	    op.fd = access.fd;
+	    op.addr = (void *)msg;
+	    op.len = 1;					// one msghdr
+	    op.flags = flags;
+	    return true;
+	}
+	Sendmsg( uIOaccess &access, int &slen, const struct msghdr *msg, int flags ) : uIOClosure( access, slen ), msg( msg ), flags( flags ) {}
+    } sendmsgClosure( access, slen, msg, flags );
+
+    if ( ! sendmsgClosure.uring( timeout ) ) sendmsgClosure.wrapper();
+    if ( slen == -1 && sendmsgClosure.errno_ == U_EWOULDBLOCK ) {
+	if ( ! sendmsgClosure.select( uCluster::WriteSelect, timeout ) ) {
+	    writeTimeout( (const char *)msg, 0, flags, NULL, 0, timeout, "sendmsg" );
+	} // if
+    } // if
+    if ( slen == -1 ) {
+	writeFailure( sendmsgClosure.errno_, (const char *)msg, 0, flags, NULL, 0, timeout, "sendmsg" );
+    } // if
+
+    return slen;
+} // uSocketIO::sendmsg
+
+
+#if defined( __linux__ )
+int uSocketIO::sendmmsg( struct mmsghdr *msgvec, unsigned int vlen, int flags, uDuration *timeout ) {
+    int cnt;
+
+    struct Sendmmsg : public uIOClosure {
+	struct mmsghdr *msgvec;
+	unsigned int vlen;
+	int flags;
+
+	int action() { return ::sendmmsg( access.fd, msgvec, vlen, flags ); }
+	Sendmmsg( uIOaccess &access, int &cnt, struct mmsghdr *msgvec, unsigned int vlen, int flags ) :
+	    uIOClosure( access, cnt ), msgvec( msgvec ), vlen( vlen ), flags( flags ) {}
+    } sendmmsgClosure( access, cnt, msgvec, vlen, flags );
+
+    sendmmsgClosure.wrapper();				// partial batch => return count sent
+    if ( cnt == -1 && sendmmsgClosure.errno_ == U_EWOULDBLOCK ) {
+	if ( ! sendmmsgClosure.select( uCluster::WriteSelect, timeout ) ) {
+	    writeTimeout( (const char *)msgvec, vlen, flags, NULL, 0, timeout, "sendmmsg" );
+	} // if
+    } // if
+    if ( cnt == -1 ) {
+	writeFailure( sendmmsgClosure.errno_, (const char *)msgvec, vlen, flags, NULL, 0, timeout, "sendmmsg" );
+    } // if
+
+    return cnt;
+} // uSocketIO::sendmmsg
+
+
+int uSocketIO::recvmmsg( struct mmsghdr *msgvec, unsigned int vlen, int flags, uDuration *timeout ) {
+    int cnt;
+
+    struct Recvmmsg : public uIOClosure {
+	struct mmsghdr *msgvec;
+	unsigned int vlen;
+	int flags;
+
+	// Non-blocking socket => return the messages already queued, up to vlen, so one readiness event drains a batch.
+	int action() { return ::recvmmsg( access.fd, msgvec, vlen, flags, NULL ); }
+	Recvmmsg( uIOaccess &access, int &cnt, struct mmsghdr *msgvec, unsigned int vlen, int flags ) :
+	    uIOClosure( access, cnt ), msgvec( msgvec ), vlen( vlen ), flags( flags ) {}
+    } recvmmsgClosure( access, cnt, msgvec, vlen, flags );
+
+    recvmmsgClosure.wrapper();
+    if ( cnt == -1 && recvmmsgClosure.errno_ == U_EWOULDBLOCK ) {
+	if ( ! recvmmsgClosure.select( uCluster::ReadSelect, timeout ) ) {
+	    readTimeout( (const char *)msgvec, vlen, flags, NULL, NULL, timeout, "recvmmsg" );
+	} // if
+    } // if
+    if ( cnt == -1 ) {
+	readFailure( recvmmsgClosure.errno_, (const char *)msgvec, vlen, flags, NULL, NULL, timeout, "recvmmsg" );
+    } // if
+
+    return cnt;
+} // uSocketIO::recvmmsg
+#endif // __linux__
+
+
 ssize_t uSocketIO::sendfile( uFile::FileAccess &file, off_t *off, size_t len, uDuration *timeout ) {
     int ret;
     off_t wlen;
@@ -336,7 +453,7 @@ ssize_t uSocketIO::sendfile( uFile::FileAccess &file, off_t *off, size_t len, uD
 	    off_t ret;
 	    //access.poll.clearPollFlag( access.fd );	// blocking sendfile
 #ifdef __U_STATISTICS__
-	    uFetchAdd( UPP::Statistics::sendfile_syscalls, 1 );
+	    uFetchAdd( UPP::Statistics::counters().sendfile_syscalls, 1 );
 #endif // __U_STATISTICS__
 	    // solaris/freebsd returns -1/EWOULDBLOCK for a partial sendfile
 #if defined( __freebsd__ )
@@ -361,6 +478,68 @@ ssize_t uSocketIO::sendfile( uFile::FileAccess &file, off_t *off, size_t len, uD
 	    uIOClosure( access, ret ), in_fd( in_fd ), off( off ), len( len ), wlen( wlen ), direct( true ) {}
     } sendfileClosure( access, ret, file.fd(), off, len, wlen );
 
+#if defined( __linux__ )
+    // With io_uring, the disk file is spliced into a pipe and the pipe into the socket, which is the equivalent of
+    // sendfile except neither the disk read nor the socket write blocks the processor.
+
+    int pipefd[2];
+    if ( timeout == NULL && uThisCluster().getIOUring() && ::pipe2( pipefd, O_CLOEXEC ) == 0 ) {
+	static const size_t PipeSize = 64 * 1024;	// default pipe capacity, so filling the pipe never blocks
+
+	struct Splice : public uIOClosure {
+	    int in_fd, out_fd;
+	    off_t *off;					// offset in input file, NULL => current position
+	    size_t len;
+
+	    int action() { return ::splice( in_fd, off, out_fd, NULL, len, SPLICE_F_MOVE ); }
+	    bool prep( UPP::uIOUringOp &op ) {
+		op.opcode = UPP::uIOUringOp::Splice;
+		op.fdIn = in_fd;
+		op.offIn = off != NULL ? *off : -1;
+		op.fd = out_fd;
+		op.off = -1;
+		op.len = len;
+		op.flags = SPLICE_F_MOVE;
+		return true;
+	    } // prep
+	    Splice( uIOaccess &access, int &ret, int in_fd, off_t *off, int out_fd ) :
+		uIOClosure( access, ret ), in_fd( in_fd ), out_fd( out_fd ), off( off ), len( 0 ) {}
+	}; // Splice
+	Splice fillClosure( access, ret, file.fd(), off, pipefd[1] ); // disk file to pipe
+	Splice drainClosure( access, ret, pipefd[0], NULL, access.fd ); // pipe to socket
+
+	size_t count;
+	for ( count = 0; count < len; ) {
+	    fillClosure.len = len - count < PipeSize ? len - count : PipeSize;
+	    if ( fillClosure.uring( NULL ) ) {
+		if ( ret > 0 && off != NULL ) *off += ret; // kernel only advances offset for current position
+	    } else {
+		fillClosure.wrapper();
+	    } // if
+	  if ( ret == 0 ) break;			// end of file
+	    if ( ret == -1 ) {
+		::close( pipefd[0] ); ::close( pipefd[1] );
+		sendfileFailure( fillClosure.errno_, file.fd(), off, len, timeout );
+	    } // if
+	    for ( drainClosure.len = ret; drainClosure.len != 0; drainClosure.len -= ret ) {
+		if ( ! drainClosure.uring( NULL ) ) {
+		    drainClosure.wrapper();
+		    if ( ret == -1 && drainClosure.errno_ == U_EWOULDBLOCK ) {
+			drainClosure.select( uCluster::WriteSelect, NULL );
+		    } // if
+		} // if
+		if ( ret == -1 ) {
+		    ::close( pipefd[0] ); ::close( pipefd[1] );
+		    sendfileFailure( drainClosure.errno_, file.fd(), off, len, timeout );
+		} // if
+		count += ret;
+	    } // for
+	} // for
+	::close( pipefd[0] ); ::close( pipefd[1] );
+	return count;
+    } // if
+#endif // __linux__
+
     // sendfile is unusual because it is both blocking and nonblocking, i.e., it is blocking on disk I/O and nonblocking
     // on socket I/O. To handle the nonblocking socket I/O requires using select in uNBIO; however, uNBIO should not
     // perform the sendfile on behalf of the user when the socket becomes available because it could block on file I/O
@@ -371,11 +550,11 @@ ssize_t uSocketIO::sendfile( uFile::FileAccess &file, off_t *off, size_t len, uD
 	sendfileClosure.len = len - count;
 	sendfileClosure.wrapper();
 #ifdef __U_STATISTICS__
-	if ( count == 0 && wlen == (__typeof__(wlen))len ) { uFetchAdd( UPP::Statistics::first_sendfile, 1 ); };
+	if ( count == 0 && wlen == (__typeof__(wlen))len ) { uFetchAdd( UPP::Statistics::counters().first_sendfile, 1 ); };
 #endif // __U_STATISTICS__
 	if ( ret == -1 && sendfileClosure.errno_ == U_EWOULDBLOCK ) {
 #ifdef __U_STATISTICS__
-	    uFetchAdd( UPP::Statistics::sendfile_eagain, 1 );
+	    uFetchAdd( UPP::Statistics::counters().sendfile_eagain, 1 );
 #endif // __U_STATISTICS__
 	    sendfileClosure.direct = false;		// do not perform sendfile in uNBIO
 	    if ( ! sendfileClosure.select( uCluster::WriteSelect, timeout ) ) {
@@ -385,7 +564,7 @@ ssize_t uSocketIO::sendfile( uFile::FileAccess &file, off_t *off, size_t len, uD
 	} // if
 	if ( ret == -1 ) {
 #ifdef __U_STATISTICS__
-	    uFetchAdd( UPP::Statistics::sendfile_errors, 1 );
+	    uFetchAdd( UPP::Statistics::counters().sendfile_errors, 1 );
 #endif // __U_STATISTICS__
 	    sendfileFailure( sendfileClosure.errno_, file.fd(), off, len, timeout );
 	} // if
@@ -439,6 +618,9 @@ void uSocketServer::createSocketServer1( const char *name, int type, int protoco
     } // if
 
     acceptorCnt = 0;
+#ifdef __U_STATISTICS__
+    accept_syscalls = accept_errors = 0;
+#endif // __U_STATISTICS__
 
 #ifdef __U_DEBUG_H__
     uDebugPrt( "(uSocketServer &)%p.createSocketServer1 binding to name:%s\n", this, name );
@@ -446,7 +628,7 @@ void uSocketServer::createSocketServer1( const char *name, int type, int protoco
 } // uSockeServer::createSocketServer1
 
 
-void uSocketServer::createSocketServer2( unsigned short port, int type, int protocol, int backlog ) {
+void uSocketServer::createSocketServer2( unsigned short port, int type, int protocol, int backlog, bool reuseport ) {
     int retcode;
 
     baddrlen = saddrlen = sizeof(sockaddr_in);
@@ -455,6 +637,19 @@ void uSocketServer::createSocketServer2( unsigned short port, int type, int prot
     uDebugPrt( "(uSocketServer &)%p.createSocketServer2 attempting binding to port:%d, ip:0x%08x\n", this, port, ((inetAddr *)saddr)->sin_addr.s_addr );
 #endif // __U_DEBUG_H__
 
+    if ( reuseport ) {					// shard => several sockets bind the same port
+#ifdef SO_REUSEPORT
+	const socklen_t enable = 1;			// 1 => enable option
+	retcode = setsockopt( socket.access.fd, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable) );
+#else
+	retcode = -1;
+	errno = ENOPROTOOPT;
+#endif // SO_REUSEPORT
+	if ( retcode == -1 ) {
+	    openFailure( errno, "", port, ((inetAddr *)saddr)->sin_addr, AF_INET, type, protocol, backlog, "unable to set socket-option" );
+	} // if
+    } // if
+
     for ( ;; ) {
 	retcode = ::bind( socket.access.fd, saddr, saddrlen );
       if ( retcode != -1 || errno != EINTR ) break;	// timer interrupt ?
@@ -474,6 +669,9 @@ void uSocketServer::createSocketServer2( unsigned short port, int type, int prot
     } // if
 
     acceptorCnt = 0;
+#ifdef __U_STATISTICS__
+    accept_syscalls = accept_errors = 0;
+#endif // __U_STATISTICS__
 
 #ifdef __U_DEBUG_H__
     uDebugPrt( "(uSocketServer &)%p.createSocketServer2 binding to port:%d, ip:0x%08x\n", this, port, ((inetAddr *)saddr)->sin_addr.s_addr );
@@ -481,8 +679,8 @@ void uSocketServer::createSocketServer2( unsigned short port, int type, int prot
 } // uSocketServer::createSocketServer2
 
 
-void uSocketServer::createSocketServer3( unsigned short *port, int type, int protocol, int backlog ) {
-    createSocketServer2( 0, type, protocol, backlog );	// 0 port number => select an used port
+void uSocketServer::createSocketServer3( unsigned short *port, int type, int protocol, int backlog, bool reuseport ) {
+    createSocketServer2( 0, type, protocol, backlog, reuseport ); // 0 port number => select an used port
 
     getsockname( saddr, &saddrlen );			// insert unsed port number into address ("bind" does not do it)
 #ifdef __U_DEBUG_H__
@@ -563,6 +761,44 @@ void uSocketServer::openFailure( int errno_, const char *const name, const unsig
 } // uSocketServer::openFailure
 
 
+//######################### uSocketServerShards #########################
+
+
+void uSocketServerShards::createShards( unsigned short *port, in_addr ip, int type, int protocol, int backlog ) {
+#ifdef __U_DEBUG__
+    if ( cnt == 0 ) {
+	uAbort( "(uSocketServerShards &)%p.uSocketServerShards : number of shards must be greater than 0.", this );
+    } // if
+#endif // __U_DEBUG__
+    shards = new Shard[cnt];
+    for ( unsigned int i = 0; i < cnt; i += 1 ) {
+	shards[i].cluster = new uCluster( "uSocketServerShard" );
+	shards[i].processor = new uProcessor( *shards[i].cluster );
+	// 0 port => first shard selects an unused port, which the remaining shards reuse
+	shards[i].server = new uSocketServer( port, ip, type, protocol, backlog, true );
+    } // for
+} // uSocketServerShards::createShards
+
+
+uSocketServerShards::~uSocketServerShards() {
+    for ( unsigned int i = 0; i < cnt; i += 1 ) {
+	delete shards[i].server;
+	delete shards[i].processor;
+	delete shards[i].cluster;
+    } // for
+    delete [] shards;
+} // uSocketServerShards::~uSocketServerShards
+
+
+uSocketServer &uSocketServerShards::local() {
+    uCluster &cluster = uThisCluster();
+    for ( unsigned int i = 0; i < cnt; i += 1 ) {
+	if ( shards[i].cluster == &cluster ) return *shards[i].server;
+    } // for
+    uAbort( "(uSocketServerShards &)%p.local() : task %.256s (%p) is not executing on a shard cluster.", this, uThisTask().getName(), &uThisTask() );
+} // uSocketServerShards::local
+
+
 //######################### uSocketAccept #########################
 
 
@@ -570,19 +806,42 @@ void uSocketAccept::createSocketAcceptor( uDuration *timeout, struct sockaddr *a
     struct Accept : public uIOClosure {
 	struct sockaddr *adr;
 	socklen_t *len;
+	unsigned int *syscalls;				// per server count
 
 	int action() {
 	    int fd, tmp = 0;
 #ifdef __U_STATISTICS__
-	    uFetchAdd( UPP::Statistics::accept_syscalls, 1 );
+	    uFetchAdd( UPP::Statistics::counters().accept_syscalls, 1 );
+	    uFetchAdd( *syscalls, 1 );
 #endif // __U_STATISTICS__
 	    if ( len != NULL ) tmp = *len;		// save *len, as it may be set to 0 after each attempt
+#if defined( __linux__ )
+	    fd = ::accept4( access.fd, adr, len, SOCK_NONBLOCK | SOCK_CLOEXEC ); // no fcntl calls to set non-blocking
+#else
 	    fd = ::accept( access.fd, adr, len );
+#endif // __linux__
 	    if ( len != NULL && *len == 0 ) *len = tmp;	// reset *len after each attempt
 	    return fd;
 	} // action
-	Accept( uIOaccess &access, int &fd, struct sockaddr *adr, socklen_t *len ) : uIOClosure( access, fd ), adr( adr ), len( len ) {}
-    } acceptClosure( socketserver.access, access.fd, adr, len );
+	bool prep( UPP::uIOUringOp &op ) {
+	    op.opcode = UPP::uIOUringOp::Accept;
+	    op.fd = access.fd;
+	    op.addr = adr;
+	    op.addr2 = len;
+#if defined( __linux__ )
+	    op.flags = SOCK_NONBLOCK | SOCK_CLOEXEC;	// accept4 flags
+#endif // __linux__
+	    return true;
+	} // prep
+	Accept( uIOaccess &access, int &fd, struct sockaddr *adr, socklen_t *len, unsigned int *syscalls ) :
+	    uIOClosure( access, fd ), adr( adr ), len( len ), syscalls( syscalls ) {}
+    } acceptClosure( socketserver.access, access.fd, adr, len,
+#ifdef __U_STATISTICS__
+		     &socketserver.accept_syscalls
+#else
+		     NULL
+#endif // __U_STATISTICS__
+	);
 
     baddrlen = saddrlen = socketserver.saddrlen;
 
@@ -590,7 +849,7 @@ void uSocketAccept::createSocketAcceptor( uDuration *timeout, struct sockaddr *a
     uDebugPrt( "(uSocketAccept &)%p.uSocketAccept before accept\n", this );
 #endif // __U_DEBUG_H__
 
-    acceptClosure.wrapper();
+    if ( ! acceptClosure.uring( timeout ) ) acceptClosure.wrapper();
     if ( access.fd == -1 && acceptClosure.errno_ == U_EWOULDBLOCK ) {
 	if ( ! acceptClosure.select( uCluster::ReadSelect, timeout ) ) {
 	    openTimeout( timeout, adr, len );
@@ -598,7 +857,8 @@ void uSocketAccept::createSocketAcceptor( uDuration *timeout, struct sockaddr *a
     } // if
     if ( access.fd == -1 ) {
 #ifdef __U_STATISTICS__
-	uFetchAdd( UPP::Statistics::accept_errors, 1 );
+	uFetchAdd( UPP::Statistics::counters().accept_errors, 1 );
+	uFetchAdd( socketserver.accept_errors, 1 );
 #endif // __U_STATISTICS__
 	openFailure( acceptClosure.errno_, timeout, adr, len );
     } // if
@@ -608,10 +868,13 @@ void uSocketAccept::createSocketAcceptor( uDuration *timeout, struct sockaddr *a
 #endif // __U_DEBUG_H__
 
     // On some UNIX systems the file descriptor created by accept inherits the non-blocking characteristic from the base
-    // socket; on other system this does not seem to occur, so explicitly set the file descriptor to non-blocking.
+    // socket; on other system this does not seem to occur, so explicitly set the file descriptor to non-blocking. On
+    // Linux, accept4 creates the file descriptor non-blocking.
 
     access.poll.setStatus( uPoll::AlwaysPoll );
+#if ! defined( __linux__ )
     access.poll.setPollFlag( access.fd );
+#endif // ! __linux__
     openAccept = true;
 } // uSocketAccept::createSocketAcceptor
 
@@ -180,6 +180,55 @@ class uSocketIO : public uFileIO {
 
     int recvmsg( struct msghdr *msg, int flags = 0, uDuration *timeout = NULL );
 
+    // Scatter-gather forms of send/sendto/recv/recvfrom, one message from or into many buffers.
+
+    int sendv( const struct iovec *iov, int iovcnt, int flags = 0, uDuration *timeout = NULL ) {
+	return sendtov( iov, iovcnt, NULL, 0, flags, timeout );
+    } // uSocketIO::sendv
+
+    int sendtov( const struct iovec *iov, int iovcnt, struct sockaddr *to, socklen_t tolen, int flags = 0, uDuration *timeout = NULL ) {
+	struct msghdr msg;
+	memset( &msg, '\0', sizeof(msg) );
+	msg.msg_name = to;
+	msg.msg_namelen = tolen;
+	msg.msg_iov = (struct iovec *)iov;
+	msg.msg_iovlen = iovcnt;
+	return sendmsg( &msg, flags, timeout );
+    } // uSocketIO::sendtov
+
+    int sendtov( const struct iovec *iov, int iovcnt, int flags = 0, uDuration *timeout = NULL ) {
+	return sendtov( iov, iovcnt, saddr, saddrlen, flags, timeout );
+    } // uSocketIO::sendtov
+
+    int recvv( const struct iovec *iov, int iovcnt, int flags = 0, uDuration *timeout = NULL ) {
+	return recvfromv( iov, iovcnt, NULL, NULL, flags, timeout );
+    } // uSocketIO::recvv
+
+    int recvfromv( const struct iovec *iov, int iovcnt, struct sockaddr *from, socklen_t *fromlen, int flags = 0, uDuration *timeout = NULL ) {
+	struct msghdr msg;
+	memset( &msg, '\0', sizeof(msg) );
+	msg.msg_name = from;
+	msg.msg_namelen = fromlen != NULL ? *fromlen : 0;
+	msg.msg_iov = (struct iovec *)iov;
+	msg.msg_iovlen = iovcnt;
+	int rlen = recvmsg( &msg, flags, timeout );
+	if ( fromlen != NULL ) *fromlen = msg.msg_namelen;
+	return rlen;
+    } // uSocketIO::recvfromv
+
+    int recvfromv( const struct iovec *iov, int iovcnt, int flags = 0, uDuration *timeout = NULL ) {
+	saddrlen = baddrlen;				// set to receive buffer size
+	return recvfromv( iov, iovcnt, saddr, &saddrlen, flags, timeout );
+    } // uSocketIO::recvfromv
+
+#if defined( __linux__ )
+    // Batched forms, many messages per system call. A call blocks (or times out) only when no message can be
+    // transferred, and returns the number of messages transferred; the length of each is in its msg_len field.
+
+    int sendmmsg( struct mmsghdr *msgvec, unsigned int vlen, int flags = 0, uDuration *timeout = NULL );
+    int recvmmsg( struct mmsghdr *msgvec, unsigned int vlen, int flags = 0, uDuration *timeout = NULL );
+#endif // __linux__
+
     ssize_t sendfile( uFile::FileAccess &file, off_t *off, size_t len, uDuration *timeout = NULL );
 }; // uSocketIO
 
@@ -189,9 +238,13 @@ class uSocketIO : public uFileIO {
 
 _Monitor uSocketServer : public uSocketIO {
     friend class uSocketAccept;				// access: socket, acceptor, unacceptor, ~uSocketAccept
+    friend class uSocketServerShards;			// access: uSocketServer, ~uSocketServer
 
     int acceptorCnt;					// number of simultaneous acceptors using server
     uSocket socket;					// one-to-one correspondance between server and socket
+#ifdef __U_STATISTICS__
+    unsigned int accept_syscalls, accept_errors;	// accepts on this server, also counted in the kernel statistics
+#endif // __U_STATISTICS__
 
     void acceptor() {
 	uFetchAdd( acceptorCnt, 1 );
@@ -202,8 +255,18 @@ _Monitor uSocketServer : public uSocketIO {
     } // uSocketServer::unacceptor
 
     void createSocketServer1( const char *name, int type, int protocol, int backlog );
-    void createSocketServer2( unsigned short port, int type, int protocol, int backlog );
-    void createSocketServer3( unsigned short *port, int type, int protocol, int backlog );
+    void createSocketServer2( unsigned short port, int type, int protocol, int backlog, bool reuseport = false );
+    void createSocketServer3( unsigned short *port, int type, int protocol, int backlog, bool reuseport = false );
+
+    // AF_INET, shard of uSocketServerShards, 0 port => select unused port and return it
+    uSocketServer( unsigned short *port, in_addr ip, int type, int protocol, int backlog, bool reuseport ) :
+	    uSocketIO( socket.access, (sockaddr *)new inetAddr( *port, ip ) ), socket( AF_INET, type, protocol ) {
+	if ( *port == 0 ) {
+	    createSocketServer3( port, type, protocol, backlog, reuseport );
+	} else {
+	    createSocketServer2( *port, type, protocol, backlog, reuseport );
+	} // if
+    } // uSocketServer::uSocketServer
   protected:
     void readFailure( int errno_, const char *buf, const int len, const uDuration *timeout, const char *const op ) __attribute__ ((noreturn));
     void readTimeout( const char *buf, const int len, const uDuration *timeout, const char *const op ) __attribute__ ((noreturn));
@@ -360,9 +423,89 @@ _Monitor uSocketServer : public uSocketIO {
 	*len = baddrlen;
 	memcpy( addr, saddr, baddrlen );
     } // uSocketServer::getServer
+
+#ifdef __U_STATISTICS__
+    _Nomutex unsigned int acceptSyscalls() const {	// accept calls on this server
+	return accept_syscalls;
+    } // uSocketServer::acceptSyscalls
+
+    _Nomutex unsigned int acceptErrors() const {	// failed accepts on this server
+	return accept_errors;
+    } // uSocketServer::acceptErrors
+#endif // __U_STATISTICS__
 }; // uSocketServer
 
 
+//######################### uSocketServerShards #########################
+
+
+// A set of AF_INET servers bound to the same port and address with SO_REUSEPORT. The kernel spreads incoming
+// connections across the listening sockets, so each shard has its own accept queue and only the acceptors of one shard
+// are woken for a connection. Each shard has a cluster with one processor; acceptors created on a shard's cluster poll
+// the shard's socket and the accepted connections with that cluster's I/O poller, so connections stay on the processor
+// that accepted them.
+
+class uSocketServerShards {
+    struct Shard {
+	uCluster *cluster;
+	uProcessor *processor;
+	uSocketServer *server;
+    }; // Shard
+
+    unsigned int cnt;
+    Shard *shards;
+
+    uSocketServerShards( uSocketServerShards & );	// no copy
+    uSocketServerShards &operator=( uSocketServerShards & ); // no assignment
+
+    void createShards( unsigned short *port, in_addr ip, int type, int protocol, int backlog );
+  public:
+    uSocketServerShards( unsigned int shards, unsigned short port, int type = SOCK_STREAM, int protocol = 0, int backlog = 10 ) : cnt( shards ) {
+	createShards( &port, uSocket::itoip( INADDR_ANY ), type, protocol, backlog );
+    } // uSocketServerShards::uSocketServerShards
+
+    uSocketServerShards( unsigned int shards, unsigned short port, in_addr ip, int type = SOCK_STREAM, int protocol = 0, int backlog = 10 ) : cnt( shards ) {
+	createShards( &port, ip, type, protocol, backlog );
+    } // uSocketServerShards::uSocketServerShards
+
+    uSocketServerShards( unsigned int shards, unsigned short *port, int type = SOCK_STREAM, int protocol = 0, int backlog = 10 ) : cnt( shards ) {
+	*port = 0;					// 0 port number => first shard selects an unused port
+	createShards( port, uSocket::itoip( INADDR_ANY ), type, protocol, backlog );
+    } // uSocketServerShards::uSocketServerShards
+
+    uSocketServerShards( unsigned int shards, unsigned short *port, in_addr ip, int type = SOCK_STREAM, int protocol = 0, int backlog = 10 ) : cnt( shards ) {
+	*port = 0;
+	createShards( port, ip, type, protocol, backlog );
+    } // uSocketServerShards::uSocketServerShards
+
+    ~uSocketServerShards();
+
+    unsigned int size() const {
+	return cnt;
+    } // uSocketServerShards::size
+
+    uSocketServer &operator[]( unsigned int i ) {
+#ifdef __U_DEBUG__
+	if ( i >= cnt ) {
+	    uAbort( "(uSocketServerShards &)%p.operator[]( %u ) : shard index out of range 0..%u.", this, i, cnt - 1 );
+	} // if
+#endif // __U_DEBUG__
+	return *shards[i].server;
+    } // uSocketServerShards::operator[]
+
+    uCluster &cluster( unsigned int i ) {		// create the acceptors for shard i on this cluster
+#ifdef __U_DEBUG__
+	if ( i >= cnt ) {
+	    uAbort( "(uSocketServerShards &)%p.cluster( %u ) : shard index out of range 0..%u.", this, i, cnt - 1 );
+	} // if
+#endif // __U_DEBUG__
+	return *shards[i].cluster;
+    } // uSocketServerShards::cluster
+
+    uSocketServer &local();				// shard of the calling task's cluster
+}; // uSocketServerShards
+
+
 //######################### uSocketAccept #########################
 
 
@@ -60,7 +60,7 @@ class uCeilingQ : public uBasePrioritySeq {
 
     int add( uBaseTaskDL *node, uBaseTask *owner ) {
 #ifdef KNOT
-	uFetchAdd( UPP::Statistics::mutex_queue, 1 );
+	uFetchAdd( UPP::Statistics::counters().mutex_queue, 1 );
 #endif // KNOT
 	list.addTail( node );
 	return 0;
@@ -68,14 +68,14 @@ class uCeilingQ : public uBasePrioritySeq {
 
     uBaseTaskDL *drop() {
 #ifdef KNOT
-	uFetchAdd( UPP::Statistics::mutex_queue, -1 );
+	uFetchAdd( UPP::Statistics::counters().mutex_queue, -1 );
 #endif // KNOT
 	return list.dropHead();
     } // uCeilingQ::drop
 
     void remove( uBaseTaskDL *node ) {
 #ifdef KNOT
-	uFetchAdd( UPP::Statistics::mutex_queue, -1 );
+	uFetchAdd( UPP::Statistics::counters().mutex_queue, -1 );
 #endif // KNOT
 	list.remove( node );
     } // uCeilingQ::remove
@@ -0,0 +1,223 @@
+//                              -*- Mode: C++ -*-
+//
+// uC++ Version 6.1.0, Copyright (C) Peter A. Buhr 2015
+//
+// uDeadlineHeap.cc --
+//
+// Author           : Peter A. Buhr
+// Created On       : Mon Feb  9 10:14:32 2015
+// Last Modified By : Peter A. Buhr
+// Last Modified On : Mon Feb  9 17:51:26 2015
+// Update Count     : 52
+//
+// This  library is free  software; you  can redistribute  it and/or  modify it
+// under the terms of the GNU Lesser General Public License as published by the
+// Free Software  Foundation; either  version 2.1 of  the License, or  (at your
+// option) any later version.
+//
+// This library is distributed in the  hope that it will be useful, but WITHOUT
+// ANY  WARRANTY;  without even  the  implied  warranty  of MERCHANTABILITY  or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+// for more details.
+//
+// You should  have received a  copy of the  GNU Lesser General  Public License
+// along  with this library.
+//
+
+#define __U_KERNEL__
+#include <uC++.h>
+#include <uDeadlineHeap.h>
+
+//#include <uDebug.h>
+
+
+// compare for Heapify property, ie parent(i) <= i
+int uDeadlineHeap::compare( Key k1, Key k2 ) {
+    if ( k1.level != k2.level ) return k1.level < k2.level ? 1 : -1;
+    if ( k1.deadline != k2.deadline ) return k1.deadline < k2.deadline ? 1 : -1;
+    if ( k1.interval != k2.interval ) return k1.interval < k2.interval ? 1 : -1;
+    if ( k1.ticket != k2.ticket ) return k1.ticket < k2.ticket ? 1 : -1;
+    return 0;
+} // uDeadlineHeap::compare
+
+
+void uDeadlineHeap::exchange( uHeapable<Key, uBaseTaskDL *> &x, uHeapable<Key, uBaseTaskDL *> &y ) {
+    uHeapable<Key, uBaseTaskDL *> temp = x;
+    int t_index = getReadyIndex( x.data->task() );
+    x = y;
+    y = temp;
+    setReadyIndex( y.data->task(), getReadyIndex( x.data->task() ) ); // swapping locations requires the indexes to be updated
+    setReadyIndex( x.data->task(), t_index );
+} // uDeadlineHeap::exchange
+
+
+// Compute the ordering of a task from the task it currently inherits from, which is itself unless it owns a mutex
+// object on which a more urgent task is blocked.
+
+void uDeadlineHeap::key( uBaseTask &task, Key &k ) {
+    uBaseTask &inherit = getInheritTask( task );
+    uRealTimeBaseTask *rtask;
+
+    if ( &inherit == &task ) {				// common case, kind known from base priority
+	rtask = getBasePriority( task ) != NonRealTime ? static_cast<uRealTimeBaseTask *>(&task) : NULL;
+    } else {
+	rtask = dynamic_cast<uRealTimeBaseTask *>(&inherit);
+    } // if
+
+    k.ticket = 0;
+    if ( rtask == NULL ) {
+	k.level = NonRealTime;
+	k.deadline = k.interval = 0;
+    } else {
+	k.level = rtask->interval != 0 ? Periodic : Aperiodic;
+	k.deadline = absolute ? ( rtask->release + rtask->getDeadline() ).nanoseconds() : rtask->getDeadline().nanoseconds();
+	k.interval = rtask->interval.nanoseconds();
+    } // if
+} // uDeadlineHeap::key
+
+
+// Record the kind of task in its base priority and cache its period or frame, so scheduling a task never needs a
+// dynamic cast.
+
+void uDeadlineHeap::classify( uBaseTask &task ) {
+    uRealTimeBaseTask *rtask = dynamic_cast<uRealTimeBaseTask *>(&task);
+    int level;
+
+    if ( rtask == NULL ) {
+	level = NonRealTime;
+    } else {
+	uPeriodicBaseTask *ptask;
+	uSporadicBaseTask *stask;
+
+	if ( ( ptask = dynamic_cast<uPeriodicBaseTask *>(rtask) ) != NULL ) {
+	    rtask->interval = ptask->getPeriod();
+	} else if ( ( stask = dynamic_cast<uSporadicBaseTask *>(rtask) ) != NULL ) {
+	    rtask->interval = stask->getFrame();
+	} else {
+	    rtask->interval = 0;
+	} // if
+	level = rtask->interval != 0 ? Periodic : Aperiodic;
+    } // if
+
+    setBasePriority( task, level );
+    setBaseQueue( task, level );			// queue number for uPriorityQ entry queues
+    if ( &getInheritTask( task ) == &task ) {		// not inheriting ?
+	setActiveQueue( task, level );
+    } // if
+    setActivePriority( task, getInheritTask( task ) );
+} // uDeadlineHeap::classify
+
+
+uDeadlineHeap::uDeadlineHeap( bool absolute ) : absolute( absolute ), heap( &compare, &exchange ) {
+    tickets = 0;
+    tasks = capacity = 0;
+} // uDeadlineHeap::uDeadlineHeap
+
+
+bool uDeadlineHeap::empty() const {
+    return heap.size() == 0;
+} // uDeadlineHeap::empty
+
+
+void uDeadlineHeap::add( uBaseTaskDL *node ) {
+    uBaseTask &task = node->task();
+
+    if ( absolute && getBasePriority( task ) != NonRealTime ) { // start a new release ?
+	uRealTimeBaseTask &rtask = static_cast<uRealTimeBaseTask &>(task);
+	uTime now = uThisProcessor().getClock().getTime();
+	if ( rtask.release + rtask.getDeadline() <= now ) {
+	    rtask.release = now;
+	} // if
+    } // if
+
+    Key k;
+    key( task, k );
+    k.ticket = tickets;
+    tickets += 1;
+    // the index must be set before inserting because the index can change as part of the insert
+    setReadyIndex( task, heap.size() + 1 );
+    heap.insert( k, node );
+#ifdef __U_DEBUG_H__
+    uDebugPrt( "(uDeadlineHeap &)%p.add( %p ) task %.256s (%p) level %d deadline %lld\n",
+	       this, node, task.getName(), &task, k.level, k.deadline );
+#endif // __U_DEBUG_H__
+} // uDeadlineHeap::add
+
+
+uBaseTaskDL *uDeadlineHeap::drop() {
+  if ( empty() ) return NULL;
+    uBaseTaskDL *node = heap.A[1].data;
+    heap.deleteRoot();
+    setReadyIndex( node->task(), 0 );
+    return node;
+} // uDeadlineHeap::drop
+
+
+void uDeadlineHeap::remove( uBaseTaskDL *node ) {
+    heap.deleteAt( getReadyIndex( node->task() ) );
+    setReadyIndex( node->task(), 0 );
+} // uDeadlineHeap::remove
+
+
+void uDeadlineHeap::transfer( uBaseTaskSeq &from, unsigned int ) {
+    for ( uBaseTaskDL *node = from.dropHead(); node != NULL; node = from.dropHead() ) {
+	add( node );					// each task goes to its place in the heap
+    } // for
+} // uDeadlineHeap::transfer
+
+
+bool uDeadlineHeap::checkPriority( uBaseTaskDL &owner, uBaseTaskDL &calling ) {
+    Key ko, kc;
+    key( owner.task(), ko );
+    key( calling.task(), kc );
+    return compare( kc, ko ) == 1;			// calling task more urgent ?
+} // uDeadlineHeap::checkPriority
+
+
+void uDeadlineHeap::resetPriority( uBaseTaskDL &owner, uBaseTaskDL &calling ) {
+    if ( getReadyIndex( owner.task() ) != 0 ) {		// owner ready ? => reposition in heap
+	remove( &owner );
+	setActivePriority( owner.task(), calling.task() );
+	add( &owner );
+    } else {
+	setActivePriority( owner.task(), calling.task() );
+    } // if
+} // uDeadlineHeap::resetPriority
+
+
+void uDeadlineHeap::addInitialize( uBaseTaskDL *taskNode, uBaseTaskSeq & ) {
+    classify( taskNode->task() );
+
+    // The heap never holds more elements than there are tasks on the cluster, so grow it here, where allocation is
+    // safe, rather than in add, which may be called from the kernel.
+
+    tasks += 1;
+    if ( tasks > capacity ) {
+	capacity = tasks;
+	heap.A[capacity].data = NULL;			// subscripting allocates, element is beyond the heap
+    } // if
+} // uDeadlineHeap::addInitialize
+
+
+void uDeadlineHeap::removeInitialize( uBaseTaskDL *, uBaseTaskSeq & ) {
+    tasks -= 1;
+} // uDeadlineHeap::removeInitialize
+
+
+void uDeadlineHeap::rescheduleTask( uBaseTaskDL *taskNode, uBaseTaskSeq & ) {
+    uBaseTask &task = taskNode->task();
+
+    if ( getReadyIndex( task ) != 0 ) {			// task ready ? => reposition with new deadline, period or frame
+	uBaseTaskDL *node = heap.A[getReadyIndex( task )].data;
+	remove( node );
+	classify( task );
+	add( node );
+    } else {
+	classify( task );
+    } // if
+} // uDeadlineHeap::rescheduleTask
+
+
+// Local Variables: //
+// compile-command: "make install" //
+// End: //
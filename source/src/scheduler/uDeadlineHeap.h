@@ -0,0 +1,105 @@
+//                              -*- Mode: C++ -*-
+//
+// uC++ Version 6.1.0, Copyright (C) Peter A. Buhr 2015
+//
+// uDeadlineHeap.h -- Earliest-deadline-first and deadline-monotonic ready queues ordered by a heap of tasks.
+//
+// Author           : Peter A. Buhr
+// Created On       : Mon Feb  9 10:14:32 2015
+// Last Modified By : Peter A. Buhr
+// Last Modified On : Mon Feb  9 17:48:05 2015
+// Update Count     : 37
+//
+// This  library is free  software; you  can redistribute  it and/or  modify it
+// under the terms of the GNU Lesser General Public License as published by the
+// Free Software  Foundation; either  version 2.1 of  the License, or  (at your
+// option) any later version.
+//
+// This library is distributed in the  hope that it will be useful, but WITHOUT
+// ANY  WARRANTY;  without even  the  implied  warranty  of MERCHANTABILITY  or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+// for more details.
+//
+// You should  have received a  copy of the  GNU Lesser General  Public License
+// along  with this library.
+//
+
+
+#ifndef __U_DEADLINEHEAP_H__
+#define __U_DEADLINEHEAP_H__
+
+#pragma __U_NOT_USER_CODE__
+
+
+#include <uRealTime.h>
+#include <uFlexArray.h>
+#include <uHeap.h>
+
+
+// Unlike uDeadlineMonotonic, which ranks every task on the cluster into one of __U_MAX_NUMBER_PRIORITIES__ priorities
+// and rebuilds the ready queue whenever the ranking changes, the ready queue is a heap of the ready tasks ordered
+// directly by deadline, so adding, removing or rescheduling a task is O(log n) and there is no limit on the number of
+// distinct deadlines. Periodic and sporadic tasks precede aperiodic real-time tasks, which precede non-real-time tasks;
+// equal deadlines are ordered by period (frame) and then by arrival. A task that inherits from a task blocked on one of
+// its mutex objects is ordered by the deadline of that task.
+
+class uDeadlineHeap : public uBaseSchedule<uBaseTaskDL> {
+    enum { Periodic, Aperiodic, NonRealTime = __U_MAX_NUMBER_PRIORITIES__ - 1 }; // base priorities, periodic includes sporadic
+
+    struct Key {
+	int level;					// Periodic, Aperiodic or NonRealTime
+	long long int deadline;				// nanoseconds, relative or absolute
+	long long int interval;				// nanoseconds, period or frame
+	unsigned long long int ticket;			// arrival order
+    }; // Key
+
+    const bool absolute;				// order by absolute (true) or relative (false) deadline
+    uDynamicHeap<Key, uBaseTaskDL *> heap;
+    unsigned long long int tickets;			// next arrival number
+    int tasks, capacity;				// tasks on cluster, heap elements allocated
+
+    static int compare( Key k1, Key k2 );
+    static void exchange( uHeapable<Key, uBaseTaskDL *> &x, uHeapable<Key, uBaseTaskDL *> &y );
+    void key( uBaseTask &task, Key &k );
+    void classify( uBaseTask &task );
+  protected:
+    uDeadlineHeap( bool absolute );
+  public:
+    bool empty() const;
+    void add( uBaseTaskDL *node );
+    uBaseTaskDL *drop();
+    void remove( uBaseTaskDL *node );
+    void transfer( uBaseTaskSeq &from, unsigned int n );
+    bool checkPriority( uBaseTaskDL &owner, uBaseTaskDL &calling );
+    void resetPriority( uBaseTaskDL &owner, uBaseTaskDL &calling );
+    void addInitialize( uBaseTaskDL *taskNode, uBaseTaskSeq &taskList );
+    void removeInitialize( uBaseTaskDL *taskNode, uBaseTaskSeq &taskList );
+    void rescheduleTask( uBaseTaskDL *taskNode, uBaseTaskSeq &taskList );
+    bool initializeTasks() const { return true; }	// base priorities depend on the kind of task
+}; // uDeadlineHeap
+
+
+// A release starts when a real-time task becomes ready after its previous absolute deadline has passed, i.e., when a
+// periodic task wakes for its next period, and ends at the release time plus the task's deadline. A task preempted or
+// blocked during its release keeps its absolute deadline.
+
+class uEarliestDeadlineFirst : public uDeadlineHeap {
+  public:
+    uEarliestDeadlineFirst() : uDeadlineHeap( true ) {}
+}; // uEarliestDeadlineFirst
+
+
+class uDeadlineMonotonicHeap : public uDeadlineHeap {
+  public:
+    uDeadlineMonotonicHeap() : uDeadlineHeap( false ) {}
+}; // uDeadlineMonotonicHeap
+
+
+#pragma __U_USER_CODE__
+
+#endif // __U_DEADLINEHEAP_H__
+
+
+// Local Variables: //
+// compile-command: "make install" //
+// End: //
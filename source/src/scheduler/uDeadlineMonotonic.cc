@@ -146,7 +146,7 @@ int uDeadlineMonotonic::compare( uBaseTask &task1, uBaseTask &task2 ) {
 } // uDeadlineMonotonic::compare
 
 
-void uDeadlineMonotonic::addInitialize( uSequence<uBaseTaskDL> &taskList ) {
+void uDeadlineMonotonic::addInitialize( uBaseTaskDL *taskNode, uSequence<uBaseTaskDL> &taskList ) {
 #ifdef __U_DEBUG_H__
     uDebugPrt( "(uDeadlineMonotonic &)%p.addInitialize: enter\n", this );
 #endif // __U_DEBUG_H__
@@ -155,13 +155,12 @@ void uDeadlineMonotonic::addInitialize( uSequence<uBaseTaskDL> &taskList ) {
     int cnt = 0;
     uBaseTaskDL *ref = NULL, *prev = NULL, *node = NULL;
 
-    // The cluster's list of tasks is maintained in sorted order. This
-    // algorithm relies on the kernel code adding new tasks to the end of the
-    // cluster's list of tasks.  (Perhaps better to combine adding tasks to a
-    // cluster list with initializing newly scheduled tasks so only one call is
-    // made in uTaskAdd.)
+    // The cluster's list of tasks is maintained in sorted order. The added or
+    // rescheduled task, taskNode, is moved to its sorted position in the
+    // cluster's list of tasks, and priorities are only recalculated when the
+    // task's version differs from the scheduler's.
 
-    uRealTimeBaseTask *rtb = dynamic_cast<uRealTimeBaseTask *>(&(taskList.tail()->task()));
+    uRealTimeBaseTask *rtb = dynamic_cast<uRealTimeBaseTask *>(&(taskNode->task()));
 
     if ( rtb == NULL ) {
 #ifdef __U_DEBUG_H__
@@ -170,14 +169,8 @@ void uDeadlineMonotonic::addInitialize( uSequence<uBaseTaskDL> &taskList ) {
 	return;
     } // exit
 
-    ref = taskList.dropTail();
-
-    if ( ref == NULL ) {				// necessary if addInitialize is called from removeInitialize
-#ifdef __U_DEBUG_H__
-	uDebugPrt( "(uDeadlineMonotonic &)%p.addInitialize: exit2\n", this );
-#endif // __U_DEBUG_H__
-	return;
-    } // exit
+    ref = taskNode;
+    taskList.remove( ref );
 
     for ( iter.over(taskList), prev = NULL; iter >> node ; prev = node ) { // find place in the list to insert
 	if ( compare( ref->task(), node->task() ) < 0 ) break;
@@ -240,20 +233,18 @@ void uDeadlineMonotonic::addInitialize( uSequence<uBaseTaskDL> &taskList ) {
 } // uDeadlineMonotonic::addInitialize
 
 
-void uDeadlineMonotonic::removeInitialize( uSequence<uBaseTaskDL> & ) {
+void uDeadlineMonotonic::removeInitialize( uBaseTaskDL *, uSequence<uBaseTaskDL> & ) {
     // Although removing a task may leave a hole in the priorities, the hole
     // should not affect the ability to schedule the task or the order the
     // tasks execute. Therefore, no rescheduling is performed.
 
-//	addInitialize( taskList );
+//	addInitialize( taskNode, taskList );
 } // uDeadlineMonotonic::removeInitialize
 
 
 void uDeadlineMonotonic::rescheduleTask( uBaseTaskDL *taskNode, uBaseTaskSeq &taskList ) {
     verCount += 1;
-    taskList.remove( taskNode );
-    taskList.addTail( taskNode );
-    addInitialize( taskList );
+    addInitialize( taskNode, taskList );
 } // uDeadlineMonotonic::rescheduleTask
 
 
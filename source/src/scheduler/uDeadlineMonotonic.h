@@ -37,9 +37,10 @@
 class uDeadlineMonotonic : public uPriorityScheduleSeq<uBaseTaskSeq, uBaseTaskDL> {
     int compare( uBaseTask &task1, uBaseTask &task2 );
   public:
-    void addInitialize( uSequence<uBaseTaskDL> &taskList );
-    void removeInitialize( uSequence<uBaseTaskDL> & );
+    void addInitialize( uBaseTaskDL *taskNode, uSequence<uBaseTaskDL> &taskList );
+    void removeInitialize( uBaseTaskDL *taskNode, uSequence<uBaseTaskDL> &taskList );
     void rescheduleTask( uBaseTaskDL *taskNode, uBaseTaskSeq &taskList );
+    bool initializeTasks() const { return true; }	// priorities depend on the task set
 }; // uDeadlineMonotonic
 
 
@@ -31,12 +31,12 @@
 //#include <uDebug.h>
 
 
-void uDeadlineMonotonic1::addInitialize( uSequence<uBaseTaskDL> &taskList ) {
+void uDeadlineMonotonic1::addInitialize( uBaseTaskDL *taskNode, uSequence<uBaseTaskDL> &taskList ) {
 #ifdef __U_DEBUG_H__
     uDebugPrt( "(uDeadlineMonotonic1 &)%p.addInitialize: enter\n", this );
 #endif // __U_DEBUG_H__
 
-    uBaseTask &task = taskList.tail()->task();
+    uBaseTask &task = taskNode->task();
 
     uPIHeap *PIHptr = dynamic_cast<uPIHeap *>(task.uPIQ);
     if ( PIHptr == NULL ) {
@@ -119,20 +119,18 @@ void uDeadlineMonotonic1::addInitialize( uSequence<uBaseTaskDL> &taskList ) {
 } // uDeadlineMonotonic1::addInitialize
 
 
-void uDeadlineMonotonic1::removeInitialize( uSequence<uBaseTaskDL> & ) {
+void uDeadlineMonotonic1::removeInitialize( uBaseTaskDL *, uSequence<uBaseTaskDL> & ) {
     // Although removing a task may leave a hole in the priorities, the hole
     // should not affect the ability to schedule the task or the order the
     // tasks execute. Therefore, no rescheduling is performed.
 
-//	addInitialize( taskList );
+//	addInitialize( taskNode, taskList );
 } // uDeadlineMonotonic1::removeInitialize
 
 
 void uDeadlineMonotonic1::rescheduleTask( uBaseTaskDL *taskNode, uBaseTaskSeq &taskList ) {
     //verCount += 1;
-    taskList.remove( taskNode );
-    taskList.addTail( taskNode );
-    addInitialize( taskList );
+    addInitialize( taskNode, taskList );
 } // uDeadlineMonotonic1::rescheduleTask
 
 
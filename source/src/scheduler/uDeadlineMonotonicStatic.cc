@@ -144,18 +144,18 @@ int uDeadlineMonotonicStatic::compare( uBaseTask &task1, uBaseTask &task2 ) {
 } // uDeadlineMonotonicStatic::compare
 
 
-void uDeadlineMonotonicStatic::addInitialize( uSequence<uBaseTaskDL> &taskList ) {
+void uDeadlineMonotonicStatic::addInitialize( uBaseTaskDL *taskNode, uSequence<uBaseTaskDL> &taskList ) {
 #ifdef __U_DEBUG_H__
     uDebugPrt( "(uDeadlineMonotonicStatic &)%p.addInitialize: enter\n", this );
 #endif // __U_DEBUG_H__
     uSeqIter<uBaseTaskDL> iter;
     uBaseTaskDL *ref = NULL, *prev = NULL, *node = NULL;
 
-    // The cluster's list of tasks is maintained in sorted order. This algorithm relies on the kernel code adding new
-    // tasks to the end of the cluster's list of tasks.  (Perhaps better to combine adding tasks to a cluster list with
-    // initializing newly scheduled tasks so only one call is made in uTaskAdd.)
+    // The cluster's list of tasks is maintained in sorted order. The added or rescheduled task, taskNode, is moved to
+    // its sorted position in the cluster's list of tasks, and priorities are only recalculated when the task's version
+    // differs from the scheduler's.
 
-    uRealTimeBaseTask *rtb = dynamic_cast<uRealTimeBaseTask *>(&(taskList.tail()->task()));
+    uRealTimeBaseTask *rtb = dynamic_cast<uRealTimeBaseTask *>(&(taskNode->task()));
 
     if ( rtb == NULL ) {
 #ifdef __U_DEBUG_H__
@@ -164,14 +164,8 @@ void uDeadlineMonotonicStatic::addInitialize( uSequence<uBaseTaskDL> &taskList )
 	return;
     } // exit
 
-    ref = taskList.dropTail();
-
-    if ( ref == NULL ) {				// necessary if addInitialize is called from removeInitialize
-#ifdef __U_DEBUG_H__
-	uDebugPrt( "(uDeadlineMonotonicStatic &)%p.addInitialize: exit2\n", this );
-#endif // __U_DEBUG_H__
-	return;
-    } // exit
+    ref = taskNode;
+    taskList.remove( ref );
 
     for ( iter.over(taskList), prev = NULL; iter >> node ; prev = node ) { // find place in the list to insert
 	if ( compare( ref->task(), node->task() ) < 0 ) break;
@@ -242,19 +236,17 @@ void uDeadlineMonotonicStatic::addInitialize( uSequence<uBaseTaskDL> &taskList )
 } // uDeadlineMonotonicStatic::addInitialize
 
 
-void uDeadlineMonotonicStatic::removeInitialize( uSequence<uBaseTaskDL> & ) {
+void uDeadlineMonotonicStatic::removeInitialize( uBaseTaskDL *, uSequence<uBaseTaskDL> & ) {
     // Although removing a task may leave a hole in the priorities, the hole should not affect the ability to schedule
     // the task or the order the tasks execute. Therefore, no rescheduling is performed.
 
-//	addInitialize( taskList );
+//	addInitialize( taskNode, taskList );
 } // uDeadlineMonotonicStatic::removeInitialize
 
 
 void uDeadlineMonotonicStatic::rescheduleTask( uBaseTaskDL *taskNode, uBaseTaskSeq &taskList ) {
     verCount += 1;
-    taskList.remove(taskNode);
-    taskList.addTail(taskNode);
-    addInitialize(taskList);
+    addInitialize( taskNode, taskList );
 } // uDeadlineMonotonicStatic::rescheduleTask
 
 
@@ -168,14 +168,18 @@ template<typename List, typename Node> class uPriorityScheduleQ : public uBaseSc
     virtual void resetPriority( Node &, Node & ) {
     } // uPriorityScheduleQ::resetPriority
 
-    virtual void addInitialize( uBaseTaskSeq & ) {
+    virtual void addInitialize( uBaseTaskDL *, uBaseTaskSeq & ) {
     } // uPriorityScheduleQ::addInitialize
 
-    virtual void removeInitialize( uBaseTaskSeq & ) {
+    virtual void removeInitialize( uBaseTaskDL *, uBaseTaskSeq & ) {
     } // uPriorityScheduleQ::removeInitialize
 
     virtual void rescheduleTask( uBaseTaskDL *, uBaseTaskSeq & ) {
     } // uPriorityScheduleQ::rescheduleTask
+
+    virtual bool initializeTasks() const {
+	return false;
+    } // uPriorityScheduleQ::initializeTasks
 }; // uPriorityScheduleQ
 
 
@@ -232,7 +236,9 @@ template<typename List, typename Node> class uPriorityScheduleQSeq : public uPri
     } // uPriorityScheduleQSeq::remove
 
     virtual void transfer( uBaseTaskSeq &from, unsigned int n ) {
-	uAbort( "uPriorityScheduleQSeq::transfer, internal error, unsupported operation" );
+	for ( uBaseTaskDL *node = from.dropHead(); node != NULL; node = from.dropHead() ) {
+	    this->add( node );				// each task goes to its priority queue
+	} // for
     } // uPriorityScheduleQSeq::transfer
 }; // uPriorityScheduleQSeq
 
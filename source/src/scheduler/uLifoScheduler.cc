@@ -48,12 +48,14 @@ bool uLifoScheduler::checkPriority( uBaseTaskDL &, uBaseTaskDL & ) { return fals
 
 void uLifoScheduler::resetPriority( uBaseTaskDL &, uBaseTaskDL & ) {}
 
-void uLifoScheduler::addInitialize( uBaseTaskSeq & ) {};
+void uLifoScheduler::addInitialize( uBaseTaskDL *, uBaseTaskSeq & ) {};
 
-void uLifoScheduler::removeInitialize( uBaseTaskSeq & ) {};
+void uLifoScheduler::removeInitialize( uBaseTaskDL *, uBaseTaskSeq & ) {};
 
 void uLifoScheduler::rescheduleTask( uBaseTaskDL *, uBaseTaskSeq & ) {};
 
+bool uLifoScheduler::initializeTasks() const { return false; };
+
 
 // Local Variables: //
 // compile-command: "make install" //
@@ -40,9 +40,10 @@ class uLifoScheduler : public uBaseSchedule<uBaseTaskDL> {
     uBaseTaskDL *drop();
     bool checkPriority( uBaseTaskDL &owner, uBaseTaskDL &calling );
     void resetPriority( uBaseTaskDL &owner, uBaseTaskDL &calling );
-    void addInitialize( uBaseTaskSeq &taskList );
-    void removeInitialize( uBaseTaskSeq &taskList );
+    void addInitialize( uBaseTaskDL *taskNode, uBaseTaskSeq &taskList );
+    void removeInitialize( uBaseTaskDL *taskNode, uBaseTaskSeq &taskList );
     void rescheduleTask( uBaseTaskDL *taskNode, uBaseTaskSeq &taskList );
+    bool initializeTasks() const;
 }; // uLifoScheduler
 
 #pragma __U_USER_CODE__
@@ -33,9 +33,9 @@
 //######################### uRealTimeBaseTask #########################
 
 
-uRealTimeBaseTask::uRealTimeBaseTask( uCluster &cluster ) : uBaseTask( cluster ) {};
+uRealTimeBaseTask::uRealTimeBaseTask( uCluster &cluster ) : uBaseTask( cluster ), release( 0 ) {};
 
-uRealTimeBaseTask::uRealTimeBaseTask( uTime firstActivateTask_, uTime endTime_, uDuration deadline_, uCluster &cluster ) : uBaseTask( cluster ) {
+uRealTimeBaseTask::uRealTimeBaseTask( uTime firstActivateTask_, uTime endTime_, uDuration deadline_, uCluster &cluster ) : uBaseTask( cluster ), release( 0 ) {
     if ( deadline_ < 0 ) {
 	uAbort( "Attempt to create real time task with deadline less than 0." );
     } // if
@@ -44,7 +44,7 @@ uRealTimeBaseTask::uRealTimeBaseTask( uTime firstActivateTask_, uTime endTime_,
     deadline = deadline_;
 } // uRealTimeBaseTask::uRealTimeBaseTask
 
-uRealTimeBaseTask::uRealTimeBaseTask( uEvent firstActivateEvent_, uTime endTime_, uDuration deadline_, uCluster &cluster ) : uBaseTask( cluster ) {
+uRealTimeBaseTask::uRealTimeBaseTask( uEvent firstActivateEvent_, uTime endTime_, uDuration deadline_, uCluster &cluster ) : uBaseTask( cluster ), release( 0 ) {
     if ( deadline_ < 0 ) {
 	uAbort( "Attempt to create real time task with deadline less than 0." );
     } // if
@@ -54,7 +54,7 @@ uRealTimeBaseTask::uRealTimeBaseTask( uEvent firstActivateEvent_, uTime endTime_
     deadline = deadline_;
 } // uRealTimeBaseTask::uRealTimeBaseTask
 
-uRealTimeBaseTask::uRealTimeBaseTask( uTime firstActivateTask_, uEvent firstActivateEvent_, uTime endTime_, uDuration deadline_, uCluster &cluster ) : uBaseTask( cluster ) {
+uRealTimeBaseTask::uRealTimeBaseTask( uTime firstActivateTask_, uEvent firstActivateEvent_, uTime endTime_, uDuration deadline_, uCluster &cluster ) : uBaseTask( cluster ), release( 0 ) {
     if ( deadline_ < 0 ) {
 	uAbort( "Attempt to create real time task with deadline less than 0." );
     } // if
@@ -111,7 +111,9 @@ template<typename List, typename Node> class uPriorityScheduleQueue : public uBa
     } // uPriorityScheduleQueue::drop
 
     virtual void transfer( uBaseTaskSeq &from, unsigned int n ) {
-	uAbort( "uPriorityScheduleQueue::transfer, internal error, unsupported operation" );
+	for ( uBaseTaskDL *node = from.dropHead(); node != NULL; node = from.dropHead() ) {
+	    this->add( node );				// each task goes to its priority queue
+	} // for
     } // uPriorityScheduleQueue::transfer
 
     virtual bool checkPriority( Node &, Node & ) {
@@ -121,14 +123,18 @@ template<typename List, typename Node> class uPriorityScheduleQueue : public uBa
     virtual void resetPriority( Node &, Node & ) {
     } // uPriorityScheduleQueue::resetPriority
 
-    virtual void addInitialize( uBaseTaskSeq & ) {
+    virtual void addInitialize( uBaseTaskDL *, uBaseTaskSeq & ) {
     } // uPriorityScheduleQueue::addInitialize
 
-    virtual void removeInitialize( uBaseTaskSeq & ) {
+    virtual void removeInitialize( uBaseTaskDL *, uBaseTaskSeq & ) {
     } // uPriorityScheduleQueue::removeInitialize
 
     virtual void rescheduleTask( uBaseTaskDL *, uBaseTaskSeq & ) {
     } // uPriorityScheduleQueue::rescheduleTask
+
+    virtual bool initializeTasks() const {
+	return false;
+    } // uPriorityScheduleQueue::initializeTasks
 }; // uPriorityScheduleQueue
 
 
@@ -249,7 +255,9 @@ template<typename List, typename Node> class uPriorityScheduleSeq : public uPrio
     } // uPriorityScheduleSeq::remove
 
     virtual void transfer( uBaseTaskSeq &from, unsigned int n ) {
-	uAbort( "uPriorityScheduleSeq::transfer, internal error, unsupported operation" );
+	for ( uBaseTaskDL *node = from.dropHead(); node != NULL; node = from.dropHead() ) {
+	    this->add( node );				// each task goes to its priority queue
+	} // for
     } // uPriorityScheduleSeq::transfer
 }; // uPriorityScheduleSeq
 
@@ -258,6 +266,8 @@ template<typename List, typename Node> class uPriorityScheduleSeq : public uPrio
 
 
 class uRealTimeBaseTask : public uBaseTask {
+    friend class uDeadlineHeap;				// access: release, interval
+
     class VerCount : public uSeqable {
       public:
 	int version;
@@ -266,6 +276,8 @@ class uRealTimeBaseTask : public uBaseTask {
 
     uDuration deadline;
     uSequence<VerCount> verCountSeq;			// list of scheduler version counts with associated cluster
+    uTime release;					// start of current release, absolute deadline is release + deadline
+    uDuration interval;					// period or frame, 0 => aperiodic
   protected:
     uTime firstActivateTime;
     uEvent firstActivateEvent;
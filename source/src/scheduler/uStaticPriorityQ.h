@@ -173,14 +173,18 @@ template<typename List, typename Node> class uStaticPriorityScheduleQ : public u
     virtual void resetPriority( Node &, Node & ) {
     } // uStaticPriorityScheduleQ::resetPriority
 
-    virtual void addInitialize( uBaseTaskSeq & ) {
+    virtual void addInitialize( uBaseTaskDL *, uBaseTaskSeq & ) {
     } // uStaticPriorityScheduleQ::addInitialize
 
-    virtual void removeInitialize( uBaseTaskSeq & ) {
+    virtual void removeInitialize( uBaseTaskDL *, uBaseTaskSeq & ) {
     } // uStaticPriorityScheduleQ::removeInitialize
 
     virtual void rescheduleTask( uBaseTaskDL *, uBaseTaskSeq & ) {
     } // uStaticPriorityScheduleQ::rescheduleTask
+
+    virtual bool initializeTasks() const {
+	return false;
+    } // uStaticPriorityScheduleQ::initializeTasks
 }; // uStaticPriorityScheduleQ
 
 
@@ -230,8 +234,10 @@ template<typename List, typename Node> class uStaticPriorityScheduleSeq : public
     } // uStaticPriorityScheduleSeq::remove
 
     virtual void transfer( uBaseTaskSeq &from, unsigned int n ) {
-	uAbort( "uStaticPriorityScheduleSeq::transfer, internal error, unsupported operation" );
-    } // uStaticPriorityScheduleSeq
+	for ( uBaseTaskDL *node = from.dropHead(); node != NULL; node = from.dropHead() ) {
+	    this->add( node );				// each task goes to its priority queue
+	} // for
+    } // uStaticPriorityScheduleSeq::transfer
 }; // uStaticPriorityScheduleSeq
 
 